@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+# Compile-time benchmark: generates translation units with N scopes written with
+# imgui_sugar and the same N scopes written with raw Begin/End and Push/Pop calls,
+# compiles each and writes one JSON object to --output (stdout by default).
+#
+#   compile_bench.py --cxx c++ -I <imgui> -I <imgui_sugar> [--counts 0,100,1000,10000] [--repeat 3] [-D NAME ...]
+#                    [--output compile.json]
+#
+# Per TU: frontend time (-fsyntax-only), compile time (-c at --opt), object size and
+# text size, best of --repeat runs. The 0 scope TUs measure the includes alone.
+# With clang, the -ftime-trace JSONs are kept next to the objects in --out.
+#
+# Per TU also, from one more untimed -O0 compile, the number of template function
+# instantiations and of lambda bodies: InstantiateFunction events of -ftime-trace
+# with clang (lambdas only when instantiated from a template), functions of
+# -fdump-tree-original with GCC. null with other compilers.
+#
+# Codegen check: with --no-exceptions --max-text-ratio 1.0 the script exits with 1 when
+# the sugar code is larger than the raw code for any count. Exceptions are off because
+# the guard destructors are also called on the unwind path, which the raw calls do not
+# have; the normal path must compile to the same code.
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+SCOPES_PER_FUNCTION = 100
+
+# (sugar, raw) bodies for one scope, {i} is the scope index. Every scope submits one widget.
+SCOPES = [
+    ('with_Window("w{i}") {{ ImGui::TextUnformatted("x"); }}',
+     'if (ImGui::Begin("w{i}")) {{ ImGui::TextUnformatted("x"); }} ImGui::End();'),
+    ('with_Child("c{i}") {{ ImGui::TextUnformatted("x"); }}',
+     'if (ImGui::BeginChild("c{i}")) {{ ImGui::TextUnformatted("x"); }} ImGui::EndChild();'),
+    ('with_TreeNode("t{i}") {{ ImGui::TextUnformatted("x"); }}',
+     'if (ImGui::TreeNode("t{i}")) {{ ImGui::TextUnformatted("x"); ImGui::TreePop(); }}'),
+    ('with_Menu("m{i}") {{ ImGui::TextUnformatted("x"); }}',
+     'if (ImGui::BeginMenu("m{i}")) {{ ImGui::TextUnformatted("x"); ImGui::EndMenu(); }}'),
+    ('with_ID({i}) {{ ImGui::TextUnformatted("x"); }}',
+     'ImGui::PushID({i}); ImGui::TextUnformatted("x"); ImGui::PopID();'),
+    ('with_StyleVar(ImGuiStyleVar_Alpha, 0.5f) {{ ImGui::TextUnformatted("x"); }}',
+     'ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f); ImGui::TextUnformatted("x"); ImGui::PopStyleVar();'),
+    ('with_StyleColor(ImGuiCol_Text, IM_COL32(255, 0, 0, 255)) {{ ImGui::TextUnformatted("x"); }}',
+     'ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 0, 0, 255)); ImGui::TextUnformatted("x"); ImGui::PopStyleColor();'),
+    ('with_Group {{ ImGui::TextUnformatted("x"); }}',
+     'ImGui::BeginGroup(); ImGui::TextUnformatted("x"); ImGui::EndGroup();'),
+    ('with_ItemWidth(100.0f) {{ ImGui::TextUnformatted("x"); }}',
+     'ImGui::PushItemWidth(100.0f); ImGui::TextUnformatted("x"); ImGui::PopItemWidth();'),
+    ('{{ set_StyleVar(ImGuiStyleVar_Alpha, 0.5f); ImGui::TextUnformatted("x"); }}',
+     '{{ ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f); ImGui::TextUnformatted("x"); ImGui::PopStyleVar(); }}'),
+]
+
+
+def generate(path, count, sugar):
+    lines = ['#include <imgui.h>']
+    if sugar:
+        lines.append('#include <imgui_sugar.hpp>')
+    functions = (count + SCOPES_PER_FUNCTION - 1) // SCOPES_PER_FUNCTION
+    for f in range(functions):
+        lines.append('void Part%d()' % f)
+        lines.append('{')
+        for i in range(f * SCOPES_PER_FUNCTION, min(count, (f + 1) * SCOPES_PER_FUNCTION)):
+            lines.append('    ' + SCOPES[i % len(SCOPES)][0 if sugar else 1].format(i=i))
+        lines.append('}')
+    with open(path, 'w') as out:
+        out.write('\n'.join(lines) + '\n')
+
+
+def best_time(command, repeat):
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+        elapsed = time.perf_counter() - start
+        if result.returncode != 0:
+            sys.stderr.write(' '.join(command) + '\n' + result.stderr)
+            sys.exit(1)
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def text_size(obj):
+    # Code bytes from binutils size, None when it is not available
+    if shutil.which('size') is None:
+        return None
+    result = subprocess.run(['size', obj], stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        return None
+    return int(result.stdout.splitlines()[1].split()[0])
+
+
+def supports_time_trace(cxx, out):
+    probe = os.path.join(out, 'probe.cpp')
+    with open(probe, 'w') as f:
+        f.write('int main() { return 0; }\n')
+    result = subprocess.run([cxx, '-ftime-trace', '-fsyntax-only', probe], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    return result.returncode == 0
+
+
+def count_instantiations(cxx, flags, source, out, time_trace_supported):
+    # (template functions, lambdas, method) or (None, None, None)
+    stem = os.path.join(out, os.path.splitext(os.path.basename(source))[0] + '_inst')
+    if time_trace_supported:
+        command = [cxx] + flags + ['-O0', '-c', source, '-o', stem + '.o', '-ftime-trace', '-ftime-trace-granularity=0']
+        if subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE).returncode != 0:
+            return None, None, None
+        with open(stem + '.json') as f:
+            events = json.load(f).get('traceEvents', [])
+        os.remove(stem + '.o')
+        details = [e.get('args', {}).get('detail', '') for e in events if e.get('name') == 'InstantiateFunction']
+        lambdas = sum(1 for d in details if 'lambda' in d)
+        return len(details) - lambdas, lambdas, 'ftime-trace'
+
+    dump = stem + '.original'
+    command = [cxx] + flags + ['-O0', '-c', source, '-o', stem + '.o', '-fdump-tree-original=' + dump]
+    if subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE).returncode != 0 or not os.path.exists(dump):
+        return None, None, None
+    # One ";; Function <signature> [with <arguments>] (<mangled>)" header per function body
+    functions = set()
+    with open(dump, errors='replace') as f:
+        for line in f:
+            if line.startswith(';; Function '):
+                functions.add(line.strip())
+    os.remove(dump)
+    os.remove(stem + '.o')
+    lambdas = sum(1 for fn in functions if '<lambda' in fn)
+    templates = sum(1 for fn in functions if '[with ' in fn and '<lambda' not in fn)
+    return templates, lambdas, 'fdump-tree-original'
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'c++'))
+    parser.add_argument('-I', dest='includes', action='append', default=[])
+    parser.add_argument('-D', dest='defines', action='append', default=[])
+    parser.add_argument('--std', default='c++11')
+    parser.add_argument('--opt', default='-O2')
+    parser.add_argument('--counts', default='0,100,1000,10000')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--out', default=None, help='Directory for the generated TUs (temporary by default)')
+    parser.add_argument('--output', default=None, help='JSON file to write (stdout by default)')
+    parser.add_argument('--no-exceptions', action='store_true', help='Compile with -fno-exceptions')
+    parser.add_argument('--max-text-ratio', type=float, default=None,
+                        help='Fail when sugar text bytes exceed raw text bytes times this ratio')
+    args = parser.parse_args()
+
+    out = args.out or tempfile.mkdtemp(prefix='imgui_sugar_compile_bench_')
+    os.makedirs(out, exist_ok=True)
+    flags = ['-std=' + args.std] + ['-I' + i for i in args.includes] + ['-D' + d for d in args.defines]
+    if args.no_exceptions:
+        flags.append('-fno-exceptions')
+    time_trace_supported = supports_time_trace(args.cxx, out)
+
+    results = []
+    instantiation_source = None
+    for count in [int(c) for c in args.counts.split(',')]:
+        for variant in ('raw', 'sugar'):
+            source = os.path.join(out, '%s_%d.cpp' % (variant, count))
+            obj = os.path.join(out, '%s_%d.o' % (variant, count))
+            generate(source, count, variant == 'sugar')
+            frontend = best_time([args.cxx] + flags + ['-fsyntax-only', source], args.repeat)
+            compile_flags = flags + [args.opt, '-c', source, '-o', obj] + (['-ftime-trace'] if time_trace_supported else [])
+            compile_time = best_time([args.cxx] + compile_flags, args.repeat)
+            templates, lambdas, instantiation_source = count_instantiations(args.cxx, flags, source, out, time_trace_supported)
+            results.append({
+                'variant': variant,
+                'scopes': count,
+                'frontend_ms': round(frontend * 1000.0, 1),
+                'compile_ms': round(compile_time * 1000.0, 1),
+                'object_bytes': os.path.getsize(obj),
+                'text_bytes': text_size(obj),
+                'template_instantiations': templates,
+                'lambda_instantiations': lambdas,
+            })
+
+    report = {
+        'compiler': args.cxx,
+        'flags': flags + [args.opt],
+        'time_trace': out if time_trace_supported else None,
+        'instantiations': instantiation_source,
+        'results': results,
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+            f.write('\n')
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+
+    if args.max_text_ratio is not None:
+        sys.exit(check_text_ratio(results, args.max_text_ratio))
+
+
+def check_text_ratio(results, ratio):
+    # 0 when sugar text is within ratio of raw text at every count, 77 (ctest skip) without size
+    raw = dict((r['scopes'], r['text_bytes']) for r in results if r['variant'] == 'raw')
+    status = 0
+    for r in results:
+        if r['variant'] != 'sugar' or r['scopes'] == 0:
+            continue
+        if r['text_bytes'] is None or raw[r['scopes']] is None:
+            sys.stderr.write('binutils size not found, text sizes not checked\n')
+            return 77
+        if r['text_bytes'] > raw[r['scopes']] * ratio:
+            sys.stderr.write('%d scopes: sugar text %d bytes, raw text %d bytes (max ratio %.2f)\n'
+                             % (r['scopes'], r['text_bytes'], raw[r['scopes']], ratio))
+            status = 1
+    return status
+
+
+if __name__ == '__main__':
+    main()
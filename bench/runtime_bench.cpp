@@ -0,0 +1,585 @@
+// Headless runtime benchmark: the same UI built through imgui_sugar scopes and through
+// raw ImGui calls, in NewFrame/Render loops without renderer (built font atlas, fixed
+// DisplaySize). Sweeps time whole frames against a data size or the window size.
+// Prints one JSON object to stdout.
+//
+//   imgui_sugar_runtime_bench [frames]
+//   imgui_sugar_runtime_bench_stats [frames] [sample every N frames]
+//
+// The _stats build is this file with IMGUI_SUGAR_STATS: its sugar timings against the
+// ones of the plain build are the cost of the scope statistics (raw calls are not
+// instrumented in either).
+
+#include <imgui.h>
+#include <imgui_sugar.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace
+{
+    const int MaxReps = 256;
+
+    char names[MaxReps][16];
+    ImGuiStyle style;
+    ImGuiSugar::ThemeDelta* theme = nullptr;
+
+    // One case is a scope kind, submitted reps times per frame with the same body both ways
+    struct Case
+    {
+        const char* name;
+        int reps;
+        int widgets;           // Widgets submitted inside each scope
+        void (*sugar)(int i);
+        void (*raw)(int i);
+    };
+
+    void Widget() { ImGui::TextUnformatted("x"); }
+
+    void TreeNodeV(const bool sugar, const int i, const char* fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        ImGui::SetNextItemOpen(true);
+        if (sugar)
+        {
+            with_TreeNodeV(names[i], fmt, args) { Widget(); }
+        }
+        else if (ImGui::TreeNodeV(names[i], fmt, args))
+        {
+            Widget();
+            ImGui::TreePop();
+        }
+        va_end(args);
+    }
+
+    void TreeNodeExV(const bool sugar, const int i, const char* fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        if (sugar)
+        {
+            with_TreeNodeExV(names[i], ImGuiTreeNodeFlags_DefaultOpen, fmt, args) { Widget(); }
+        }
+        else if (ImGui::TreeNodeExV(names[i], ImGuiTreeNodeFlags_DefaultOpen, fmt, args))
+        {
+            Widget();
+            ImGui::TreePop();
+        }
+        va_end(args);
+    }
+
+    // set_* guards are named after the line, so they cannot share the line of BENCH_CASE
+    void SetScopes(const int i)
+    {
+        set_ItemWidth(100.0f);
+        set_StyleVar(ImGuiStyleVar_Alpha, 0.5f);
+        set_ID(i);
+        Widget();
+    }
+
+    // 3 levels of 8 children, all open
+    struct BenchTree : ImGuiSugar::TreeSource
+    {
+        auto GetChildCount(const ImU64 node) -> int override { return node < 73 ? 8 : 0; }
+        auto GetChild(const ImU64 node, const int index) -> ImU64 override { return node * 8 + 1 + static_cast<ImU64>(index); }
+        auto GetLabel(const ImU64 node) -> const char* override { return names[node % MaxReps]; }
+        auto GetFlags(ImU64) -> ImGuiTreeNodeFlags override { return ImGuiTreeNodeFlags_DefaultOpen; }
+    };
+
+    BenchTree benchTree;
+    ImGuiSugar::FlatTree* flatTree = nullptr;
+
+    void RawTree(const ImU64 node)
+    {
+        for (int i = 0; i < benchTree.GetChildCount(node); ++i)
+        {
+            const ImU64 child = benchTree.GetChild(node, i);
+            ImGuiTreeNodeFlags flags = benchTree.GetFlags(child);
+            if (benchTree.GetChildCount(child) == 0) { flags |= ImGuiTreeNodeFlags_Leaf; }
+            if (ImGui::TreeNodeEx(benchTree.GetLabel(child), flags))
+            {
+                RawTree(child);
+                ImGui::TreePop();
+            }
+        }
+    }
+
+    // ID scopes of a 11110 node tree (4 levels of 10), the hashing a tree UI does without its drawing
+    const int IDTreeNodes = 11110;
+    ImGuiID idSink = 0;
+
+    void StaticIDTree(const int depth)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            with_ID(i)
+            {
+                with_StaticID("Transform properties")
+                {
+                    idSink ^= IMGUI_SUGAR_STATIC_ID("is open");
+                    if (depth < 3) { StaticIDTree(depth + 1); }
+                }
+            }
+        }
+    }
+
+    void RawIDTree(const int depth)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            ImGui::PushID(i);
+            ImGui::PushID("Transform properties");
+            idSink ^= ImGui::GetID("is open");
+            if (depth < 3) { RawIDTree(depth + 1); }
+            ImGui::PopID();
+            ImGui::PopID();
+        }
+    }
+
+    // What with_Style replaces: every color and every style var pushed, then popped
+    void RawStyleChain()
+    {
+        for (int c = 0; c < ImGuiCol_COUNT; ++c) { ImGui::PushStyleColor(c, style.Colors[c]); }
+        int count = 0;
+        const ImGuiSugar::StyleVarInfo* infos = ImGuiSugar::GetStyleVarInfos(count);
+        for (int v = 0; v < count; ++v)
+        {
+            const float* value = infos[v].Get(style);
+            if (infos[v].count == 2) { ImGui::PushStyleVar(infos[v].idx, ImVec2(value[0], value[1])); }
+            else                     { ImGui::PushStyleVar(infos[v].idx, value[0]); }
+        }
+        Widget();
+        ImGui::PopStyleVar(count);
+        ImGui::PopStyleColor(ImGuiCol_COUNT);
+    }
+
+    // 100 KB of words and paragraphs, wrapped at the window width
+    char wrappedText[100 * 1024];
+
+    // Short labels repeated every frame, as in table captions and units
+    const char* const labels[] = {"OK", "Cancel", "ms", "Hz", "kB", "fps", "Name", "Value"};
+    const int LabelCount = static_cast<int>(sizeof(labels) / sizeof(labels[0]));
+
+    auto LabelPos(const int i) -> ImVec2 { return ImVec2(10.0f + (i % 16) * 48.0f, 40.0f + (i / 16) * 16.0f); }
+
+    // 60 x 40 numeric cells, all visible: no cell padding so the 40 rows fit the window height
+    const int GridColumns = 60;
+    const int GridRows = 40;
+
+    auto GridValue(const int row, const int column) -> double { return row * 0.25 + column * 1000.0; }
+
+    void NumericGrid()
+    {
+        with_StyleVar(ImGuiStyleVar_CellPadding, ImVec2(2, 0))
+        {
+            with_Table("grid", GridColumns) { ImGuiSugar::TableNumericCells(GridRows, 2, &GridValue); }
+        }
+    }
+
+    // The same cells printed one by one, right aligned
+    void RawNumericGrid()
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(2, 0));
+        if (ImGui::BeginTable("grid", GridColumns))
+        {
+            for (int row = 0; row < GridRows; ++row)
+            {
+                ImGui::TableNextRow();
+                for (int column = 0; column < GridColumns; ++column)
+                {
+                    ImGui::TableSetColumnIndex(column);
+                    char text[32];
+                    const int length = snprintf(text, sizeof(text), "%.2f", GridValue(row, column));
+                    const float offset = ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize(text, text + length).x;
+                    if (offset > 0.0f) { ImGui::SetCursorPosX(ImGui::GetCursorPosX() + offset); }
+                    ImGui::TextUnformatted(text, text + length);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::PopStyleVar();
+    }
+
+#define BENCH_CASE(NAME, REPS, WIDGETS, SUGAR, RAW) \
+    { NAME, REPS, WIDGETS, [](int i) { (void)i; SUGAR }, [](int i) { (void)i; RAW } }
+
+    const Case cases[] =
+    {
+        BENCH_CASE("Window", 16, 1,
+            with_Window(names[i]) { Widget(); },
+            if (ImGui::Begin(names[i])) { Widget(); } ImGui::End();),
+        BENCH_CASE("Child", 64, 1,
+            with_Child(names[i], ImVec2(100, 20)) { Widget(); },
+            if (ImGui::BeginChild(names[i], ImVec2(100, 20))) { Widget(); } ImGui::EndChild();),
+        BENCH_CASE("ChildFrame", 64, 1,
+            with_ChildFrame(ImGui::GetID(names[i]), ImVec2(100, 20)) { Widget(); },
+            if (ImGui::BeginChildFrame(ImGui::GetID(names[i]), ImVec2(100, 20))) { Widget(); } ImGui::EndChildFrame();),
+        BENCH_CASE("Combo", 256, 0,
+            with_Combo(names[i], "preview") { Widget(); },
+            if (ImGui::BeginCombo(names[i], "preview")) { Widget(); ImGui::EndCombo(); }),
+        BENCH_CASE("ListBox", 64, 1,
+            with_ListBox(names[i], ImVec2(100, 20)) { Widget(); },
+            if (ImGui::BeginListBox(names[i], ImVec2(100, 20))) { Widget(); ImGui::EndListBox(); }),
+        BENCH_CASE("MenuBar", 1, 0,
+            with_MenuBar { with_Menu("File") { Widget(); } },
+            if (ImGui::BeginMenuBar()) { if (ImGui::BeginMenu("File")) { Widget(); ImGui::EndMenu(); } ImGui::EndMenuBar(); }),
+        BENCH_CASE("MainMenuBar", 1, 0,
+            with_MainMenuBar { with_Menu("File") { Widget(); } },
+            if (ImGui::BeginMainMenuBar()) { if (ImGui::BeginMenu("File")) { Widget(); ImGui::EndMenu(); } ImGui::EndMainMenuBar(); }),
+        BENCH_CASE("Popup", 256, 0,
+            with_Popup(names[i]) { Widget(); },
+            if (ImGui::BeginPopup(names[i])) { Widget(); ImGui::EndPopup(); }),
+        BENCH_CASE("PopupModal", 256, 0,
+            with_PopupModal(names[i]) { Widget(); },
+            if (ImGui::BeginPopupModal(names[i])) { Widget(); ImGui::EndPopup(); }),
+        BENCH_CASE("PopupContextItem", 128, 1,
+            Widget(); with_PopupContextItem(names[i]) { Widget(); },
+            Widget(); if (ImGui::BeginPopupContextItem(names[i])) { Widget(); ImGui::EndPopup(); }),
+        BENCH_CASE("PopupContextWindow", 256, 0,
+            with_PopupContextWindow(names[i]) { Widget(); },
+            if (ImGui::BeginPopupContextWindow(names[i])) { Widget(); ImGui::EndPopup(); }),
+        BENCH_CASE("PopupContextVoid", 256, 0,
+            with_PopupContextVoid(names[i]) { Widget(); },
+            if (ImGui::BeginPopupContextVoid(names[i])) { Widget(); ImGui::EndPopup(); }),
+        BENCH_CASE("Table", 32, 2,
+            with_Table(names[i], 2) { ImGui::TableNextColumn(); Widget(); ImGui::TableNextColumn(); Widget(); },
+            if (ImGui::BeginTable(names[i], 2)) { ImGui::TableNextColumn(); Widget(); ImGui::TableNextColumn(); Widget(); ImGui::EndTable(); }),
+        BENCH_CASE("TabBar/TabItem", 32, 1,
+            with_TabBar(names[i]) { with_TabItem("A") { Widget(); } with_TabItem("B") { Widget(); } },
+            if (ImGui::BeginTabBar(names[i])) { if (ImGui::BeginTabItem("A")) { Widget(); ImGui::EndTabItem(); } if (ImGui::BeginTabItem("B")) { Widget(); ImGui::EndTabItem(); } ImGui::EndTabBar(); }),
+        BENCH_CASE("DragDropSource/Target", 128, 1,
+            Widget(); with_DragDropSource() { Widget(); } with_DragDropTarget { Widget(); },
+            Widget(); if (ImGui::BeginDragDropSource()) { Widget(); ImGui::EndDragDropSource(); } if (ImGui::BeginDragDropTarget()) { Widget(); ImGui::EndDragDropTarget(); }),
+        BENCH_CASE("TreeNode", 128, 1,
+            ImGui::SetNextItemOpen(true); with_TreeNode(names[i]) { Widget(); },
+            ImGui::SetNextItemOpen(true); if (ImGui::TreeNode(names[i])) { Widget(); ImGui::TreePop(); }),
+        BENCH_CASE("TreeNodeV", 128, 1,
+            TreeNodeV(true, i, "node %d", i);,
+            TreeNodeV(false, i, "node %d", i);),
+        BENCH_CASE("TreeNodeEx", 128, 1,
+            with_TreeNodeEx(names[i], ImGuiTreeNodeFlags_DefaultOpen) { Widget(); },
+            if (ImGui::TreeNodeEx(names[i], ImGuiTreeNodeFlags_DefaultOpen)) { Widget(); ImGui::TreePop(); }),
+        BENCH_CASE("TreeNodeExV", 128, 1,
+            TreeNodeExV(true, i, "node %d", i);,
+            TreeNodeExV(false, i, "node %d", i);),
+        BENCH_CASE("TooltipOnHover", 256, 1,
+            Widget(); with_TooltipOnHover { Widget(); },
+            Widget(); if (ImGui::IsItemHovered()) { ImGui::BeginTooltip(); Widget(); ImGui::EndTooltip(); }),
+        BENCH_CASE("Tooltip", 1, 1,
+            with_Tooltip { Widget(); },
+            ImGui::BeginTooltip(); Widget(); ImGui::EndTooltip();),
+        BENCH_CASE("Group", 256, 1,
+            with_Group { Widget(); },
+            ImGui::BeginGroup(); Widget(); ImGui::EndGroup();),
+        BENCH_CASE("Font", 256, 1,
+            with_Font(ImGui::GetFont()) { Widget(); },
+            ImGui::PushFont(ImGui::GetFont()); Widget(); ImGui::PopFont();),
+        BENCH_CASE("AllowKeyboardFocus", 256, 1,
+            with_AllowKeyboardFocus(false) { Widget(); },
+            ImGui::PushAllowKeyboardFocus(false); Widget(); ImGui::PopAllowKeyboardFocus();),
+        BENCH_CASE("ButtonRepeat", 256, 1,
+            with_ButtonRepeat(true) { Widget(); },
+            ImGui::PushButtonRepeat(true); Widget(); ImGui::PopButtonRepeat();),
+        BENCH_CASE("ItemWidth", 256, 1,
+            with_ItemWidth(100.0f) { Widget(); },
+            ImGui::PushItemWidth(100.0f); Widget(); ImGui::PopItemWidth();),
+        BENCH_CASE("TextWrapPos", 256, 1,
+            with_TextWrapPos(200.0f) { Widget(); },
+            ImGui::PushTextWrapPos(200.0f); Widget(); ImGui::PopTextWrapPos();),
+        BENCH_CASE("ID", 256, 1,
+            with_ID(i) { Widget(); },
+            ImGui::PushID(i); Widget(); ImGui::PopID();),
+        BENCH_CASE("StaticID", 256, 1,
+            with_StaticID("static") { Widget(); },
+            ImGui::PushID("static"); Widget(); ImGui::PopID();),
+        BENCH_CASE("StaticID tree", 1, IDTreeNodes,
+            StaticIDTree(0);,
+            RawIDTree(0);),
+        BENCH_CASE("IDf", 256, 1,
+            with_IDf("row", i) { Widget(); },
+            char id[32]; snprintf(id, sizeof(id), "row%d", i); ImGui::PushID(id); Widget(); ImGui::PopID();),
+        BENCH_CASE("ClipRect", 256, 1,
+            with_ClipRect(ImVec2(0, 0), ImVec2(400, 400), true) { Widget(); },
+            ImGui::PushClipRect(ImVec2(0, 0), ImVec2(400, 400), true); Widget(); ImGui::PopClipRect();),
+        BENCH_CASE("TextureID", 256, 1,
+            with_TextureID(ImGui::GetIO().Fonts->TexID) { Widget(); },
+            ImGui::PushTextureID(ImGui::GetIO().Fonts->TexID); Widget(); ImGui::PopTextureID();),
+        BENCH_CASE("StyleColor", 256, 1,
+            with_StyleColor(ImGuiCol_Text, 0xff00ff00) { Widget(); },
+            ImGui::PushStyleColor(ImGuiCol_Text, 0xff00ff00); Widget(); ImGui::PopStyleColor();),
+        BENCH_CASE("StyleVar", 256, 1,
+            with_StyleVar(ImGuiStyleVar_Alpha, 0.5f) { Widget(); },
+            ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f); Widget(); ImGui::PopStyleVar();),
+        BENCH_CASE("Indent", 256, 1,
+            with_Indent(10.0f) { Widget(); },
+            ImGui::Indent(10.0f); Widget(); ImGui::Unindent(10.0f);),
+        BENCH_CASE("StyleColors", 256, 1,
+            with_StyleColors({ImGuiCol_Text, 0xff00ff00}, {ImGuiCol_Button, 0xff0000ff}) { Widget(); },
+            ImGui::PushStyleColor(ImGuiCol_Text, 0xff00ff00); ImGui::PushStyleColor(ImGuiCol_Button, 0xff0000ff); Widget(); ImGui::PopStyleColor(2);),
+        BENCH_CASE("StyleVars", 256, 1,
+            with_StyleVars({ImGuiStyleVar_Alpha, 0.5f}, {ImGuiStyleVar_ItemSpacing, ImVec2(2, 2)}) { Widget(); },
+            ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f); ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2, 2)); Widget(); ImGui::PopStyleVar(2);),
+        BENCH_CASE("Style", 64, 1,
+            with_Style(style) { Widget(); },
+            RawStyleChain();),
+        BENCH_CASE("Theme", 64, 1,
+            with_Theme(*theme) { Widget(); },
+            for (const ImGuiSugar::StyleColor& c : theme->colors) { ImGui::PushStyleColor(c.idx, c.col); } for (const ImGuiSugar::StyleVar& v : theme->vars) { if (v.isVec2) { ImGui::PushStyleVar(v.idx, v.val); } else { ImGui::PushStyleVar(v.idx, v.val.x); } } Widget(); if (theme->vars.Size > 0) { ImGui::PopStyleVar(theme->vars.Size); } if (theme->colors.Size > 0) { ImGui::PopStyleColor(theme->colors.Size); }),
+        BENCH_CASE("set_ItemWidth/StyleVar/ID", 256, 1,
+            SetScopes(i);,
+            ImGui::PushItemWidth(100.0f); ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f); ImGui::PushID(i); Widget(); ImGui::PopID(); ImGui::PopStyleVar(); ImGui::PopItemWidth();),
+        BENCH_CASE("TableRows", 1, 10000,
+            with_Table("rows", 1, ImGuiTableFlags_ScrollY) { with_TableRows(row, 10000) { ImGui::TableNextColumn(); ImGui::Text("%d", row); } },
+            if (ImGui::BeginTable("rows", 1, ImGuiTableFlags_ScrollY)) { ImGuiListClipper clipper; clipper.Begin(10000); while (clipper.Step()) { for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) { ImGui::TableNextRow(); ImGui::TableNextColumn(); ImGui::Text("%d", row); } } ImGui::EndTable(); }),
+        BENCH_CASE("TableNumericCells 60x40", 1, GridColumns * GridRows,
+            NumericGrid();,
+            RawNumericGrid();),
+        BENCH_CASE("TextWrappedCached 100 KB", 1, 1,
+            ImGuiSugar::TextWrappedCached("wrapped", wrappedText);,
+            ImGui::TextWrapped("%s", wrappedText);),
+        BENCH_CASE("TextCached", 256, 1,
+            ImGuiSugar::TextCached(labels[i % LabelCount]);,
+            ImGui::TextUnformatted(labels[i % LabelCount]);),
+        BENCH_CASE("AddTextCached", 256, 1,
+            ImGuiSugar::AddTextCached(ImGui::GetWindowDrawList(), LabelPos(i), ImGui::GetColorU32(ImGuiCol_Text), labels[i % LabelCount]);,
+            ImGui::GetWindowDrawList()->AddText(LabelPos(i), ImGui::GetColorU32(ImGuiCol_Text), labels[i % LabelCount]);),
+        BENCH_CASE("FlatTree", 1, 584,
+            with_FlatTree(node, *flatTree) { (void)node; },
+            RawTree(0);),
+        BENCH_CASE("CachedRegion", 32, 8,
+            with_CachedRegion(names[i], 1) { for (int w = 0; w < 8; ++w) { Widget(); } },
+            with_ID(names[i]) { ImGui::BeginGroup(); for (int w = 0; w < 8; ++w) { Widget(); } ImGui::EndGroup(); }),
+        BENCH_CASE("Budget/LowPriority", 32, 8,
+            with_Budget(1000000) { with_LowPriority(names[i]) { for (int w = 0; w < 8; ++w) { Widget(); } } },
+            with_ID(names[i]) { ImGui::BeginGroup(); for (int w = 0; w < 8; ++w) { Widget(); } ImGui::EndGroup(); }),
+        BENCH_CASE("CollapsingHeader", 128, 1,
+            ImGui::SetNextItemOpen(true); with_CollapsingHeader(names[i]) { Widget(); },
+            ImGui::SetNextItemOpen(true); if (ImGui::CollapsingHeader(names[i])) { Widget(); }),
+        BENCH_CASE("MenuItem", 256, 0,
+            with_MenuItem(names[i]) { Widget(); },
+            if (ImGui::MenuItem(names[i])) { Widget(); }),
+    };
+
+#undef BENCH_CASE
+
+    // Scaling sweeps: the same body timed for each value of a parameter, the data size or the
+    // height of the window (4:3), to show what the frame time depends on
+    struct Sweep
+    {
+        const char* name;
+        const char* parameter;
+        bool viewport;          // Values are window heights, the data size is count
+        int count;
+        int values[6];          // Up to the first 0
+        void (*sugar)();
+        void (*raw)();
+    };
+
+    int sweepCount = 0;         // Data size of the running sweep point, read by the bodies
+    ImVec2 windowSize(800, 600);
+
+    // Widest table of Dear ImGui 1.89.9 (IMGUI_TABLE_MAX_COLUMNS)
+    const int WideColumns = 512;
+    const ImGuiTableFlags WideFlags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+
+    void WideTableCells()
+    {
+        with_Table("wide", WideColumns, WideFlags)
+        {
+            ImGuiSugar::ForEachVisibleCell(sweepCount, [](const int row, const int column) { ImGui::Text("%d", row + column); });
+        }
+    }
+
+    // Without the helper: rows are clipped, every column is visited
+    void RawWideTableCells()
+    {
+        if (ImGui::BeginTable("wide", WideColumns, WideFlags))
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(sweepCount);
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                {
+                    ImGui::TableNextRow();
+                    for (int column = 0; column < WideColumns; ++column)
+                    {
+                        if (ImGui::TableSetColumnIndex(column)) { ImGui::Text("%d", row + column); }
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    void ListClipperItems()
+    {
+        with_ListClipper(row, sweepCount) { ImGui::Text("%d", row); }
+    }
+
+    void RawListClipperItems()
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(sweepCount);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) { ImGui::Text("%d", row); }
+        }
+    }
+
+    const Sweep sweeps[] =
+    {
+        {"ListClipper", "items", false, 0, {1000, 10000, 100000, 1000000, 10000000},
+            &ListClipperItems, &RawListClipperItems},
+        {"ForEachVisibleCell, 512 columns", "rows", false, 0, {1000, 10000, 100000, 1000000},
+            &WideTableCells, &RawWideTableCells},
+        {"ForEachVisibleCell, 512 columns x 100000 rows", "window_height", true, 100000, {240, 480, 720, 1080},
+            &WideTableCells, &RawWideTableCells},
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    auto Nanoseconds(const Clock::time_point a, const Clock::time_point b) -> double
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+    }
+
+    auto Median(std::vector<double>& values) -> double
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    struct Timing
+    {
+        double scopes;         // Median ns of the reps scopes of a frame
+        double frame;          // Median ns of the whole frame, NewFrame to Render
+    };
+
+    auto Run(void (*submit)(int), const int reps, const int frames) -> Timing
+    {
+        std::vector<double> scopes;
+        std::vector<double> frame;
+        scopes.reserve(frames);
+        frame.reserve(frames);
+
+        for (int f = -frames / 10; f < frames; ++f) // Warm up first
+        {
+            const Clock::time_point t0 = Clock::now();
+            ImGui::NewFrame();
+#ifdef IMGUI_SUGAR_STATS
+            ImGuiSugar::ScopeStatsNewFrame();
+#endif
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(windowSize);
+            ImGui::Begin("Bench", nullptr, ImGuiWindowFlags_MenuBar | ImGuiWindowFlags_NoSavedSettings);
+            const Clock::time_point t1 = Clock::now();
+            for (int i = 0; i < reps; ++i) { submit(i); }
+            const Clock::time_point t2 = Clock::now();
+            ImGui::End();
+            ImGui::Render();
+            const Clock::time_point t3 = Clock::now();
+            if (f >= 0)
+            {
+                scopes.push_back(Nanoseconds(t1, t2));
+                frame.push_back(Nanoseconds(t0, t3));
+            }
+        }
+        return Timing{Median(scopes), Median(frame)};
+    }
+
+    // Body of the running sweep, called once per frame
+    void (*sweepBody)() = nullptr;
+
+    void RunSweepBody(int) { sweepBody(); }
+
+    void PrintTiming(const Case& c, const Timing& t)
+    {
+        printf("{\"ns_per_scope\": %.1f, \"ns_per_widget\": ", t.scopes / c.reps);
+        if (c.widgets > 0) { printf("%.1f", t.scopes / (static_cast<double>(c.reps) * c.widgets)); }
+        else               { printf("null"); }
+        printf(", \"ns_per_frame\": %.1f}", t.frame);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? atoi(argv[1]) : 2000;
+#ifdef IMGUI_SUGAR_STATS
+    const int sampling = argc > 2 ? atoi(argv[2]) : 1;
+    ImGuiSugar::SetScopeStatsSampling(sampling);
+#endif
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 240.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    for (int i = 0; i < MaxReps; ++i) { snprintf(names[i], sizeof(names[i]), "item %d", i); }
+    for (size_t i = 0; i + 1 < sizeof(wrappedText); ++i)
+    {
+        wrappedText[i] = i % 400 == 399 ? '\n' : (i % 7 == 6 ? ' ' : static_cast<char>('a' + i % 26));
+    }
+    style = ImGui::GetStyle();
+    ImGui::StyleColorsLight(&style);
+    ImGuiSugar::ThemeDelta lightTheme(ImGui::GetStyle(), style);
+    theme = &lightTheme;
+    ImGuiSugar::FlatTree tree(benchTree, 0);
+    flatTree = &tree;
+
+    printf("{\"imgui\": \"%s\", \"frames\": %d, ", IMGUI_VERSION, frames);
+#ifdef IMGUI_SUGAR_STATS
+    printf("\"stats_sampling\": %d, \"cases\": [\n", sampling > 0 ? sampling : 1);
+#else
+    printf("\"stats_sampling\": null, \"cases\": [\n");
+#endif
+    const int count = static_cast<int>(sizeof(cases) / sizeof(cases[0]));
+    for (int k = 0; k < count; ++k)
+    {
+        const Case& c = cases[k];
+        const Timing sugar = Run(c.sugar, c.reps, frames);
+        const Timing raw = Run(c.raw, c.reps, frames);
+        printf("  {\"name\": \"%s\", \"scopes_per_frame\": %d, \"widgets_per_scope\": %d,\n   \"sugar\": ", c.name, c.reps, c.widgets);
+        PrintTiming(c, sugar);
+        printf(",\n   \"raw\": ");
+        PrintTiming(c, raw);
+        printf(",\n   \"overhead_ns_per_scope\": %.1f}%s\n", (sugar.scopes - raw.scopes) / c.reps, k + 1 < count ? "," : "");
+    }
+
+    // Sweeps: ns per frame for each point, NewFrame to Render
+    printf("], \"sweeps\": [\n");
+    const int sweepTotal = static_cast<int>(sizeof(sweeps) / sizeof(sweeps[0]));
+    for (int k = 0; k < sweepTotal; ++k)
+    {
+        const Sweep& sweep = sweeps[k];
+        printf("  {\"name\": \"%s\", \"parameter\": \"%s\", \"points\": [\n", sweep.name, sweep.parameter);
+        for (int v = 0; v < 6 && sweep.values[v] > 0; ++v)
+        {
+            const int value = sweep.values[v];
+            windowSize = sweep.viewport ? ImVec2(static_cast<float>(value * 4 / 3), static_cast<float>(value)) : ImVec2(800, 600);
+            sweepCount = sweep.viewport ? sweep.count : value;
+            sweepBody = sweep.sugar;
+            const Timing sugar = Run(&RunSweepBody, 1, frames);
+            sweepBody = sweep.raw;
+            const Timing raw = Run(&RunSweepBody, 1, frames);
+            const bool last = v + 1 == 6 || sweep.values[v + 1] <= 0;
+            printf("    {\"value\": %d, \"sugar_ns_per_frame\": %.1f, \"raw_ns_per_frame\": %.1f}%s\n", value, sugar.frame, raw.frame, last ? "" : ",");
+        }
+        printf("  ]}%s\n", k + 1 < sweepTotal ? "," : "");
+    }
+    windowSize = ImVec2(800, 600);
+    printf("]}\n");
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -21,77 +21,3364 @@
 // SOFTWARE.
 
 #include <imgui.h>
+#include <atomic>
+#include <chrono>
+#include <float.h> // FLT_MAX
+#include <stddef.h> // offsetof
+#include <stdio.h> // snprintf
+#include <string.h> // memcpy, memmove, memcmp, memchr, strlen
+#include <type_traits>
+
+// Features built on ImGui internals (StaticID, FlatTree, TextWrappedCached, glyph runs)
+// are opt-in, as imgui_internal.h has no API stability guarantee.
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+#include <imgui_internal.h> // PushOverrideID, GetCurrentWindow, ImHashStr, ImHashData, CalcWrapWidthForPos, ImFloor
+#endif
+
+#ifdef IMGUI_SUGAR_ENABLE_ASYNC
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#if defined(IMGUI_SUGAR_PROFILE) || defined(IMGUI_SUGAR_STATS) || defined(IMGUI_SUGAR_DRAW_STATS) || defined(IMGUI_SUGAR_ALLOC_STATS)
+#define IMGUI_SUGAR_INSTRUMENT
+#endif
+
+#ifdef IMGUI_SUGAR_INSTRUMENT
+#include <stdlib.h> // malloc, free
+#endif
 
 // clang-format off
 
-// ----------------------------------------------------------------------------
-// [SECTION] RAII guard implementations
-// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+// [SECTION] RAII guard implementations
+// ----------------------------------------------------------------------------
+
+namespace ImGuiSugar
+{
+    using ScopeEndCallback = void(*)();
+
+    // RAII scope guard for ImGui Begin* functions returning bool.
+    // END is a template argument, so it is called directly (and can be inlined).
+    template<bool AlwaysCallEnd, ScopeEndCallback End>
+    struct BooleanGuard
+    {
+        BooleanGuard(const bool state) noexcept : m_state(state) {} // (Implicit) NOLINT
+
+        BooleanGuard(const BooleanGuard<AlwaysCallEnd, End>&) = delete;
+        BooleanGuard(BooleanGuard<AlwaysCallEnd, End>&&) = delete;
+        BooleanGuard<AlwaysCallEnd, End>& operator=(const BooleanGuard<AlwaysCallEnd, End>&) = delete; // NOLINT
+        BooleanGuard<AlwaysCallEnd, End>& operator=(BooleanGuard<AlwaysCallEnd, End>&&) = delete; // NOLINT
+
+        ~BooleanGuard() noexcept 
+        { 
+            if (AlwaysCallEnd || m_state) { End(); } 
+        }
+
+        operator bool() const & noexcept { return m_state; } // (Implicit) NOLINT
+
+        private:
+            const bool m_state;
+    };
+
+    // RAII scope guard for ImGui Begin*/Push* functions returning void.
+    // State is always true and END is always called, so it has no members.
+    template<ScopeEndCallback End>
+    struct VoidGuard
+    {
+        VoidGuard(const bool) noexcept {} // (Implicit) NOLINT
+
+        VoidGuard(const VoidGuard<End>&) = delete;
+        VoidGuard(VoidGuard<End>&&) = delete;
+        VoidGuard<End>& operator=(const VoidGuard<End>&) = delete; // NOLINT
+        VoidGuard<End>& operator=(VoidGuard<End>&&) = delete; // NOLINT
+
+        ~VoidGuard() noexcept { End(); }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+    };
+
+    // (ImGuiCol, color) pair for batched style color scopes
+    struct StyleColor
+    {
+        StyleColor(const ImGuiCol index, const ImVec4& color) noexcept : idx(index), col(color) {}
+        StyleColor(const ImGuiCol index, const ImU32 color) : idx(index), col(ImGui::ColorConvertU32ToFloat4(color)) {}
+
+        ImGuiCol idx;
+        ImVec4 col;
+    };
+
+    // (ImGuiStyleVar, value) pair for batched style var scopes
+    struct StyleVar
+    {
+        // Any arithmetic value, as accepted by PushStyleVar(ImGuiStyleVar, float) (no narrowing error for doubles)
+        template<typename Value, typename std::enable_if<std::is_arithmetic<Value>::value, int>::type = 0>
+        StyleVar(const ImGuiStyleVar index, const Value value) noexcept : idx(index), val(static_cast<float>(value), 0.0f), isVec2(false) {}
+        StyleVar(const ImGuiStyleVar index, const ImVec2& value) noexcept : idx(index), val(value), isVec2(true) {}
+
+        ImGuiStyleVar idx;
+        ImVec2 val;
+        bool isVec2;
+    };
+
+    // RAII scope guard pushing Count style colors at once, popped with a single call.
+    // Count is deduced at compile time from the braced list, so the guard has no members.
+    template<int Count>
+    struct StyleColorsGuard
+    {
+        StyleColorsGuard(const StyleColor (&colors)[Count]) // (Implicit) NOLINT
+        {
+            for (const StyleColor& c : colors) { ImGui::PushStyleColor(c.idx, c.col); }
+        }
+
+        StyleColorsGuard(const StyleColorsGuard<Count>&) = delete;
+        StyleColorsGuard(StyleColorsGuard<Count>&&) = delete;
+        StyleColorsGuard<Count>& operator=(const StyleColorsGuard<Count>&) = delete; // NOLINT
+        StyleColorsGuard<Count>& operator=(StyleColorsGuard<Count>&&) = delete; // NOLINT
+
+        ~StyleColorsGuard() noexcept { ImGui::PopStyleColor(Count); }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+    };
+
+    // RAII scope guard pushing Count style vars at once, popped with a single call.
+    template<int Count>
+    struct StyleVarsGuard
+    {
+        StyleVarsGuard(const StyleVar (&vars)[Count]) // (Implicit) NOLINT
+        {
+            for (const StyleVar& v : vars)
+            {
+                if (v.isVec2) { ImGui::PushStyleVar(v.idx, v.val); }
+                else          { ImGui::PushStyleVar(v.idx, v.val.x); }
+            }
+        }
+
+        StyleVarsGuard(const StyleVarsGuard<Count>&) = delete;
+        StyleVarsGuard(StyleVarsGuard<Count>&&) = delete;
+        StyleVarsGuard<Count>& operator=(const StyleVarsGuard<Count>&) = delete; // NOLINT
+        StyleVarsGuard<Count>& operator=(StyleVarsGuard<Count>&&) = delete; // NOLINT
+
+        ~StyleVarsGuard() noexcept { ImGui::PopStyleVar(Count); }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+    };
+
+    // RAII scope guard installing a whole ImGuiStyle with one copy, restored on scope exit.
+    // Font size and scale are not part of ImGuiStyle (see io.FontGlobalScale and with_Font),
+    // so they are left untouched.
+    struct StyleGuard
+    {
+        StyleGuard(const ImGuiStyle& style) : m_backup(ImGui::GetStyle()) // (Implicit) NOLINT
+        {
+            ImGuiStyle& current = ImGui::GetStyle();
+            current = style;
+
+            // Tessellation settings are latched into the draw list shared data by NewFrame,
+            // changing them mid-frame would leave it inconsistent with the style.
+            current.CurveTessellationTol = m_backup.CurveTessellationTol;
+            current.CircleTessellationMaxError = m_backup.CircleTessellationMaxError;
+        }
+
+        StyleGuard(const StyleGuard&) = delete;
+        StyleGuard(StyleGuard&&) = delete;
+        StyleGuard& operator=(const StyleGuard&) = delete; // NOLINT
+        StyleGuard& operator=(StyleGuard&&) = delete; // NOLINT
+
+        ~StyleGuard() noexcept { ImGui::GetStyle() = m_backup; }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+
+        private:
+            const ImGuiStyle m_backup;
+    };
+
+    // Location of an ImGuiStyleVar inside ImGuiStyle (1 or 2 floats)
+    struct StyleVarInfo
+    {
+        ImGuiStyleVar idx;
+        int count;
+        size_t offset;
+
+        auto Get(const ImGuiStyle& style) const -> const float*
+        {
+            return reinterpret_cast<const float*>(reinterpret_cast<const char*>(&style) + offset);
+        }
+    };
+
+    inline auto GetStyleVarInfos(int& count) -> const StyleVarInfo*
+    {
+        static const StyleVarInfo infos[] =
+        {
+            { ImGuiStyleVar_Alpha,               1, offsetof(ImGuiStyle, Alpha)               },
+#if IMGUI_VERSION_NUM >= 18400
+            { ImGuiStyleVar_DisabledAlpha,       1, offsetof(ImGuiStyle, DisabledAlpha)       },
+#endif
+            { ImGuiStyleVar_WindowPadding,       2, offsetof(ImGuiStyle, WindowPadding)       },
+            { ImGuiStyleVar_WindowRounding,      1, offsetof(ImGuiStyle, WindowRounding)      },
+            { ImGuiStyleVar_WindowBorderSize,    1, offsetof(ImGuiStyle, WindowBorderSize)    },
+            { ImGuiStyleVar_WindowMinSize,       2, offsetof(ImGuiStyle, WindowMinSize)       },
+            { ImGuiStyleVar_WindowTitleAlign,    2, offsetof(ImGuiStyle, WindowTitleAlign)    },
+            { ImGuiStyleVar_ChildRounding,       1, offsetof(ImGuiStyle, ChildRounding)       },
+            { ImGuiStyleVar_ChildBorderSize,     1, offsetof(ImGuiStyle, ChildBorderSize)     },
+            { ImGuiStyleVar_PopupRounding,       1, offsetof(ImGuiStyle, PopupRounding)       },
+            { ImGuiStyleVar_PopupBorderSize,     1, offsetof(ImGuiStyle, PopupBorderSize)     },
+            { ImGuiStyleVar_FramePadding,        2, offsetof(ImGuiStyle, FramePadding)        },
+            { ImGuiStyleVar_FrameRounding,       1, offsetof(ImGuiStyle, FrameRounding)       },
+            { ImGuiStyleVar_FrameBorderSize,     1, offsetof(ImGuiStyle, FrameBorderSize)     },
+            { ImGuiStyleVar_ItemSpacing,         2, offsetof(ImGuiStyle, ItemSpacing)         },
+            { ImGuiStyleVar_ItemInnerSpacing,    2, offsetof(ImGuiStyle, ItemInnerSpacing)    },
+            { ImGuiStyleVar_IndentSpacing,       1, offsetof(ImGuiStyle, IndentSpacing)       },
+            { ImGuiStyleVar_CellPadding,         2, offsetof(ImGuiStyle, CellPadding)         },
+            { ImGuiStyleVar_ScrollbarSize,       1, offsetof(ImGuiStyle, ScrollbarSize)       },
+            { ImGuiStyleVar_ScrollbarRounding,   1, offsetof(ImGuiStyle, ScrollbarRounding)   },
+            { ImGuiStyleVar_GrabMinSize,         1, offsetof(ImGuiStyle, GrabMinSize)         },
+            { ImGuiStyleVar_GrabRounding,        1, offsetof(ImGuiStyle, GrabRounding)        },
+            { ImGuiStyleVar_TabRounding,         1, offsetof(ImGuiStyle, TabRounding)         },
+            { ImGuiStyleVar_ButtonTextAlign,     2, offsetof(ImGuiStyle, ButtonTextAlign)     },
+            { ImGuiStyleVar_SelectableTextAlign, 2, offsetof(ImGuiStyle, SelectableTextAlign) },
+        };
+        count = IM_ARRAYSIZE(infos);
+        return infos;
+    }
+
+    // Precomputed difference between two styles: only the colors and vars that differ.
+    // Build it once (theme load time), apply it every frame with with_Theme/set_Theme.
+    struct ThemeDelta
+    {
+        ThemeDelta(const ImGuiStyle& from, const ImGuiStyle& to)
+        {
+            for (int i = 0; i < ImGuiCol_COUNT; ++i)
+            {
+                const ImVec4& a = from.Colors[i];
+                const ImVec4& b = to.Colors[i];
+                if (a.x != b.x || a.y != b.y || a.z != b.z || a.w != b.w)
+                {
+                    colors.push_back(StyleColor(i, b));
+                }
+            }
+
+            int count = 0;
+            const StyleVarInfo* infos = GetStyleVarInfos(count);
+            for (int i = 0; i < count; ++i)
+            {
+                const StyleVarInfo& info = infos[i];
+                const float* a = info.Get(from);
+                const float* b = info.Get(to);
+                if (info.count == 1 && a[0] != b[0])
+                {
+                    vars.push_back(StyleVar(info.idx, b[0]));
+                }
+                else if (info.count == 2 && (a[0] != b[0] || a[1] != b[1]))
+                {
+                    vars.push_back(StyleVar(info.idx, ImVec2(b[0], b[1])));
+                }
+            }
+        }
+
+        ImVector<StyleColor> colors;
+        ImVector<StyleVar> vars;
+    };
+
+    // RAII scope guard applying a ThemeDelta, popped with one call per stack.
+    struct ThemeGuard
+    {
+        ThemeGuard(const ThemeDelta& delta) : m_colors(delta.colors.Size), m_vars(delta.vars.Size) // (Implicit) NOLINT
+        {
+            for (const StyleColor& c : delta.colors) { ImGui::PushStyleColor(c.idx, c.col); }
+            for (const StyleVar& v : delta.vars)
+            {
+                if (v.isVec2) { ImGui::PushStyleVar(v.idx, v.val); }
+                else          { ImGui::PushStyleVar(v.idx, v.val.x); }
+            }
+        }
+
+        ThemeGuard(const ThemeGuard&) = delete;
+        ThemeGuard(ThemeGuard&&) = delete;
+        ThemeGuard& operator=(const ThemeGuard&) = delete; // NOLINT
+        ThemeGuard& operator=(ThemeGuard&&) = delete; // NOLINT
+
+        ~ThemeGuard() noexcept
+        {
+            if (m_vars > 0)   { ImGui::PopStyleVar(m_vars); }
+            if (m_colors > 0) { ImGui::PopStyleColor(m_colors); }
+        }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+
+        private:
+            const int m_colors;
+            const int m_vars;
+    };
+
+    // Compile time size of a braced list of pairs (only used in unevaluated sizeof)
+    template<typename Item, int Count> auto CountOf(const Item (&)[Count]) -> char(&)[Count];
+
+    // For special cases, transform void(*)(int) to void(*)()
+    inline void PopStyleColor() { ImGui::PopStyleColor(1); };
+    inline void PopStyleVar()   { ImGui::PopStyleVar(1); };
+    inline void Unindent()      { ImGui::Unindent(); }
+
+    // Tooltip auto triggered on hover
+    inline auto BeginTooltip() -> bool
+    {
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            return true;
+        }
+        return false;
+    }
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Compile time IDs
+// ----------------------------------------------------------------------------
+//
+// ImHashStr(str, 0, seed) is a CRC32 (zlib polynomial) started from ~seed and
+// restarted at each "###". CRC is affine in its start state, so for a literal:
+//
+//   ImHashStr(str, 0, seed) == ~(ZeroBytes(~seed, length) ^ constant)
+//
+// where length is the number of bytes hashed after the last restart, constant
+// the CRC of those bytes from a zero state, and ZeroBytes the CRC of length
+// zero bytes (a linear map). constant and length are folded at compile time,
+// ZeroBytes is 4 table lookups in a table built once per length.
+
+namespace ImGuiSugar
+{
+    constexpr auto Crc32Bits(const ImU32 crc, const int bits) noexcept -> ImU32
+    {
+        return bits == 0 ? crc : Crc32Bits((crc & 1u) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1, bits - 1);
+    }
+
+    constexpr auto Crc32Byte(const ImU32 crc, const unsigned char c) noexcept -> ImU32
+    {
+        return (crc >> 8) ^ Crc32Bits((crc & 0xFFu) ^ c, 8);
+    }
+
+    // Index where ImHashStr last restarts ("###"), 0 if it never does
+    constexpr auto StaticIDStart(const char* str, const int i = 0, const int start = 0) noexcept -> int
+    {
+        return str[i] == 0 ? start
+            : StaticIDStart(str, i + 1, (str[i] == '#' && str[i + 1] == '#' && str[i + 2] == '#') ? i : start);
+    }
+
+    constexpr auto StaticIDEnd(const char* str, const int i = 0) noexcept -> int
+    {
+        return str[i] == 0 ? i : StaticIDEnd(str, i + 1);
+    }
+
+    constexpr auto StaticIDCrc(const char* str, const int i, const ImU32 crc) noexcept -> ImU32
+    {
+        return str[i] == 0 ? crc : StaticIDCrc(str, i + 1, Crc32Byte(crc, static_cast<unsigned char>(str[i])));
+    }
+
+    constexpr auto StaticIDLength(const char* str) noexcept -> int
+    {
+        return StaticIDEnd(str) - StaticIDStart(str);
+    }
+
+    constexpr auto StaticIDConstant(const char* str) noexcept -> ImU32
+    {
+        return StaticIDCrc(str, StaticIDStart(str), 0u);
+    }
+
+    // CRC of Length zero bytes as a linear map, split in one table per input byte
+    struct ZeroBytesTables
+    {
+        explicit ZeroBytesTables(const int length) noexcept
+        {
+            for (int b = 0; b < 4; ++b)
+            {
+                for (ImU32 x = 0; x < 256; ++x)
+                {
+                    ImU32 crc = x << (8 * b);
+                    for (int i = 0; i < length; ++i) { crc = Crc32Byte(crc, 0); }
+                    tables[b][x] = crc;
+                }
+            }
+        }
+
+        ImU32 tables[4][256];
+    };
+
+    template<int Length>
+    inline auto ZeroBytes(const ImU32 crc) noexcept -> ImU32
+    {
+        static const ZeroBytesTables zero(Length);
+        return zero.tables[0][crc & 0xFFu] ^ zero.tables[1][(crc >> 8) & 0xFFu]
+             ^ zero.tables[2][(crc >> 16) & 0xFFu] ^ zero.tables[3][crc >> 24];
+    }
+
+    // Same as ImHashStr(literal, 0, seed)
+    template<ImU32 Constant, int Length>
+    inline auto CombineStaticID(const ImGuiID seed) noexcept -> ImGuiID
+    {
+        return ~(ZeroBytes<Length>(~seed) ^ Constant);
+    }
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+
+    // Same as ImGui::GetID(literal)
+    template<ImU32 Constant, int Length>
+    inline auto StaticID() -> ImGuiID
+    {
+        return CombineStaticID<Constant, Length>(ImGui::GetCurrentWindow()->IDStack.back());
+    }
+
+#endif // IMGUI_SUGAR_ENABLE_INTERNAL
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Frame string arena
+// ----------------------------------------------------------------------------
+//
+// Labels, IDs and texts built every frame without vsnprintf nor allocations:
+//
+//   ImGui::Button(ImGuiSugar::Label("Delete##", row));
+//   ImGuiSugar::TextFast("Total: ", count, " items, ", ImGuiSugar::Fixed(ratio, 2), "%");
+//   with_IDf("row", row) { ... }
+//
+// Pieces are strings, chars, integers, floats (3 decimals like "%.3f") and
+// ImGuiSugar::Fixed(value, decimals). Strings live in a bump arena of the current
+// ImGui context, reset on the first use of each of its frames, so they stay valid
+// until the end of the frame.
+
+// Size of the arena blocks, bigger strings get their own block
+#ifndef IMGUI_SUGAR_FRAME_ARENA_BLOCK
+#define IMGUI_SUGAR_FRAME_ARENA_BLOCK 16384
+#endif
+
+namespace ImGuiSugar
+{
+    // Chunked bump allocator, its blocks are kept and reused from frame to frame
+    struct FrameArena
+    {
+        FrameArena() = default;
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete; // NOLINT
+
+        ~FrameArena()
+        {
+            for (const Block& block : m_blocks) { ImGui::MemFree(block.data); }
+        }
+
+        auto Allocate(const size_t size) -> char*
+        {
+            const int frame = ImGui::GetFrameCount();
+            if (frame != m_frame)
+            {
+                m_frame = frame;
+                m_block = 0;
+                m_used = 0;
+            }
+            for (; m_block < m_blocks.Size; ++m_block, m_used = 0)
+            {
+                if (m_used + size <= m_blocks[m_block].size)
+                {
+                    char* data = m_blocks[m_block].data + m_used;
+                    m_used += size;
+                    return data;
+                }
+            }
+            const size_t blockSize = size > IMGUI_SUGAR_FRAME_ARENA_BLOCK ? size : IMGUI_SUGAR_FRAME_ARENA_BLOCK;
+            m_blocks.push_back(Block{static_cast<char*>(ImGui::MemAlloc(blockSize)), blockSize});
+            m_used = size;
+            return m_blocks.back().data;
+        }
+
+        // Gives back the end of the last allocation, keeping its first used bytes
+        void Shrink(const char* data, const size_t used) noexcept
+        {
+            m_used = static_cast<size_t>(data - m_blocks[m_block].data) + used;
+        }
+
+        private:
+            struct Block
+            {
+                char* data;
+                size_t size;
+            };
+
+            ImVector<Block> m_blocks;
+            int m_block = 0;
+            size_t m_used = 0;
+            int m_frame = -1;
+    };
+
+    // One T per ImGui context used so far, kept until exit (a context created at the address
+    // of a destroyed one reuses it). Guarded by a spin lock, taken once per thread and
+    // context switch.
+    template<typename T>
+    struct ContextRegistry
+    {
+        ContextRegistry() = default;
+        ContextRegistry(const ContextRegistry&) = delete;
+        ContextRegistry& operator=(const ContextRegistry&) = delete; // NOLINT
+
+        ~ContextRegistry()
+        {
+            for (T* object : objects) { IM_DELETE(object); }
+        }
+
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        ImVector<ImGuiContext*> contexts;
+        ImVector<T*> objects;
+    };
+
+    template<typename T>
+    inline auto GetContextRegistry() -> ContextRegistry<T>&
+    {
+        static ContextRegistry<T> registry;
+        return registry;
+    }
+
+    // T of the current ImGui context. Like the context, use it from one thread at a time.
+    template<typename T>
+    inline auto GetContextLocal() -> T&
+    {
+        static thread_local ImGuiContext* lastContext = nullptr;
+        static thread_local T* lastObject = nullptr;
+        ImGuiContext* const context = ImGui::GetCurrentContext();
+        if (context == lastContext && lastObject != nullptr) { return *lastObject; }
+
+        ContextRegistry<T>& registry = GetContextRegistry<T>();
+        while (registry.lock.test_and_set(std::memory_order_acquire)) {}
+        T* object = nullptr;
+        for (int i = 0; i < registry.contexts.Size && object == nullptr; ++i)
+        {
+            if (registry.contexts[i] == context) { object = registry.objects[i]; }
+        }
+        if (object == nullptr)
+        {
+            object = IM_NEW(T)();
+            registry.contexts.push_back(context);
+            registry.objects.push_back(object);
+        }
+        registry.lock.clear(std::memory_order_release);
+
+        lastContext = context;
+        lastObject = object;
+        return *object;
+    }
+
+    // Arena of the current ImGui context
+    inline auto GetFrameArena() -> FrameArena&
+    {
+        return GetContextLocal<FrameArena>();
+    }
+
+    // Fixed point piece: value printed with the given decimals (0..9)
+    struct Fixed
+    {
+        Fixed(const double number, const int places) noexcept : value(number), decimals(places < 0 ? 0 : (places > 9 ? 9 : places)) {}
+
+        double value;
+        int decimals;
+    };
+
+    // Upper bound of the characters written for each piece
+
+    inline auto PieceBound(const char* str) noexcept -> size_t { return str != nullptr ? strlen(str) : 0; }
+    inline auto PieceBound(const char) noexcept -> size_t { return 1; }
+    inline auto PieceBound(const Fixed& fixed) noexcept -> size_t { return 312 + static_cast<size_t>(fixed.decimals); }
+    inline auto PieceBound(const double) noexcept -> size_t { return 315; }
+
+    template<typename Int, typename std::enable_if<std::is_integral<Int>::value, int>::type = 0>
+    inline auto PieceBound(const Int) noexcept -> size_t { return 20; }
+
+    // Writers, advancing out
+
+    inline void WritePiece(char*& out, const char* str) noexcept
+    {
+        if (str == nullptr) { return; }
+        while (*str != 0) { *out++ = *str++; }
+    }
+
+    inline void WritePiece(char*& out, const char c) noexcept { *out++ = c; }
+
+    inline void WriteDigits(char*& out, ImU64 value, const int minDigits = 1) noexcept
+    {
+        char digits[20];
+        int count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        while (value != 0 || count < minDigits);
+        while (count > 0) { *out++ = digits[--count]; }
+    }
+
+    template<typename Int, typename std::enable_if<std::is_integral<Int>::value && std::is_signed<Int>::value, int>::type = 0>
+    inline void WritePiece(char*& out, const Int value) noexcept
+    {
+        if (value < 0)
+        {
+            *out++ = '-';
+            WriteDigits(out, static_cast<ImU64>(0) - static_cast<ImU64>(value));
+        }
+        else
+        {
+            WriteDigits(out, static_cast<ImU64>(value));
+        }
+    }
+
+    template<typename Int, typename std::enable_if<std::is_integral<Int>::value && !std::is_signed<Int>::value, int>::type = 0>
+    inline void WritePiece(char*& out, const Int value) noexcept
+    {
+        WriteDigits(out, static_cast<ImU64>(value));
+    }
+
+    // First `decimals` digits of frac / 2^shift (frac < 2^shift, 0 < shift <= 124), exact.
+    // Returns how the remaining fraction compares with one half: -1, 0 or 1.
+    inline auto FractionDigits(const ImU64 frac, const int shift, const int decimals, ImU64& digits) noexcept -> int
+    {
+        digits = 0;
+        if (shift <= 60)
+        {
+            // frac * 10 stays below 2^64
+            const ImU64 mask = (1ULL << shift) - 1;
+            ImU64 x = frac;
+            for (int i = 0; i < decimals; ++i)
+            {
+                x *= 10;
+                digits = digits * 10 + (x >> shift);
+                x &= mask;
+            }
+            const ImU64 half = 1ULL << (shift - 1);
+            return x < half ? -1 : (x > half ? 1 : 0);
+        }
+
+        // 128 bits in 32 bit words, frac * 10 stays below 2^128
+        ImU32 x[4] = {static_cast<ImU32>(frac), static_cast<ImU32>(frac >> 32), 0u, 0u};
+        const int word = shift / 32;
+        const int bit = shift % 32;
+        for (int i = 0; i < decimals; ++i)
+        {
+            ImU64 carry = 0;
+            for (ImU32& w : x)
+            {
+                const ImU64 product = static_cast<ImU64>(w) * 10u + carry;
+                w = static_cast<ImU32>(product);
+                carry = product >> 32;
+            }
+            // The integer part (one digit) is at bits [shift, shift + 4)
+            const ImU64 top = x[word] | (word < 3 ? static_cast<ImU64>(x[word + 1]) << 32 : 0u);
+            digits = digits * 10 + ((top >> bit) & 0xFu);
+            x[word] &= (1u << bit) - 1u;
+            if (word < 3) { x[word + 1] = 0; }
+        }
+        const int halfWord = (shift - 1) / 32;
+        const int halfBit = (shift - 1) % 32;
+        if (((x[halfWord] >> halfBit) & 1u) == 0) { return -1; }
+        bool below = (x[halfWord] & ((1u << halfBit) - 1u)) != 0;
+        for (int w = 0; w < halfWord; ++w) { below = below || x[w] != 0; }
+        return below ? 1 : 0;
+    }
+
+    // Same output as snprintf("%.*f", decimals, value): the double is split exactly into its
+    // integer and binary fraction parts, so digits and ties (to even) match the C library.
+    inline void WritePiece(char*& out, const Fixed& fixed) noexcept
+    {
+        static const ImU64 scales[10] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+        double value = fixed.value;
+        ImU64 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if (value != value) { WritePiece(out, "nan"); return; }
+        if ((bits >> 63) != 0) { *out++ = '-'; value = -value; bits &= ~(1ULL << 63); } // -0.0 too, as printf
+        if (value - value != 0.0) { WritePiece(out, "inf"); return; }
+        if (value >= 18446744073709551616.0)
+        {
+            // Integer part beyond ImU64 (2^64): rare, left to the C library
+            out += snprintf(out, static_cast<size_t>(311 + fixed.decimals), "%.*f", fixed.decimals, value);
+            return;
+        }
+
+        // value = mantissa / 2^shift
+        const int biased = static_cast<int>(bits >> 52);
+        const ImU64 mantissa = (bits & ((1ULL << 52) - 1)) | (biased != 0 ? 1ULL << 52 : 0u);
+        const int shift = biased != 0 ? 1075 - biased : 1074;
+
+        ImU64 integer = 0;
+        ImU64 fraction = 0;
+        int half = -1; // Below 2^-71 all digits are zero and the rest is under one half
+        if (shift <= 0)        { integer = mantissa << -shift; }
+        else if (shift < 64)   { integer = mantissa >> shift; half = FractionDigits(mantissa & ((1ULL << shift) - 1), shift, fixed.decimals, fraction); }
+        else if (shift <= 124) { half = FractionDigits(mantissa, shift, fixed.decimals, fraction); }
+
+        const ImU64 scale = scales[fixed.decimals];
+        const ImU64 lastDigit = fixed.decimals > 0 ? fraction : integer;
+        if (half > 0 || (half == 0 && (lastDigit & 1u) != 0)) { ++fraction; } // Ties to even, as printf
+        if (fraction >= scale) { ++integer; fraction -= scale; }
+        WriteDigits(out, integer);
+        if (fixed.decimals > 0)
+        {
+            *out++ = '.';
+            WriteDigits(out, fraction, fixed.decimals);
+        }
+    }
+
+    inline void WritePiece(char*& out, const double value) noexcept { WritePiece(out, Fixed(value, 3)); }
+
+    // Formats the pieces into the frame arena, returns [begin, end) with a zero at end
+    template<typename... Pieces>
+    inline auto FormatPieces(const char*& end, const Pieces&... pieces) -> char*
+    {
+        const size_t bounds[] = {0, PieceBound(pieces)...};
+        size_t bound = 1;
+        for (const size_t b : bounds) { bound += b; }
+
+        FrameArena& arena = GetFrameArena();
+        char* const begin = arena.Allocate(bound);
+        char* out = begin;
+        using Expand = int[];
+        (void)Expand{0, (WritePiece(out, pieces), 0)...};
+        *out = 0;
+        arena.Shrink(begin, static_cast<size_t>(out - begin) + 1);
+        end = out;
+        return begin;
+    }
+
+    // Zero terminated string valid until the end of the frame
+    template<typename... Pieces>
+    inline auto Label(const Pieces&... pieces) -> const char*
+    {
+        const char* end;
+        return FormatPieces(end, pieces...);
+    }
+
+    template<typename... Pieces>
+    inline void TextFast(const Pieces&... pieces)
+    {
+        const char* end;
+        const char* begin = FormatPieces(end, pieces...);
+        ImGui::TextUnformatted(begin, end);
+    }
+
+    // PushID of the formatted pieces, the string itself is released right away
+    template<typename... Pieces>
+    inline void PushIDf(const Pieces&... pieces)
+    {
+        const char* end;
+        char* begin = FormatPieces(end, pieces...);
+        ImGui::PushID(begin, end);
+        GetFrameArena().Shrink(begin, 0);
+    }
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Virtualized iteration
+// ----------------------------------------------------------------------------
+
+namespace ImGuiSugar
+{
+    // Range-for over the item indices of a long list that are actually visible.
+    //
+    //   for (int i : ImGuiSugar::ListClipper(count)) { ... }          // Same height for all items (measured if itemHeight <= 0)
+    //   for (int i : ImGuiSugar::ListClipper(count, offsets)) { ... } // Variable heights: offsets[i] = top of item i
+    //                                                                  // relative to the list start, offsets[count] = total height
+    //
+    // Breaking out of the loop is fine, the clipper is ended by the destructor.
+    struct ListClipper
+    {
+        enum { MaxIncluded = 8 };
+
+        explicit ListClipper(const int count, const float itemHeight = -1.0f) noexcept
+            : m_count(count), m_itemHeight(itemHeight), m_offsets(nullptr) {}
+
+        ListClipper(const int count, const float* offsets) noexcept
+            : m_count(count), m_itemHeight(-1.0f), m_offsets(offsets) {}
+
+        ListClipper(const ListClipper&) = delete;
+        ListClipper(ListClipper&&) = delete;
+        ListClipper& operator=(const ListClipper&) = delete; // NOLINT
+        ListClipper& operator=(ListClipper&&) = delete; // NOLINT
+
+        ~ListClipper()
+        {
+            if (m_started && !m_done) { Finish(); }
+        }
+
+        // Makes an item always submitted even if not visible (e.g. keyboard navigation target).
+        // Call before iterating.
+        void IncludeItemByIndex(const int index) noexcept
+        {
+            IM_ASSERT(m_includedCount < MaxIncluded);
+            if (m_includedCount < MaxIncluded && index >= 0 && index < m_count) { m_included[m_includedCount++] = index; }
+        }
+
+        struct Iterator
+        {
+            ListClipper* clipper;
+
+            auto operator*() const noexcept -> int { return clipper->m_index; }
+            auto operator++() -> Iterator& { clipper->Advance(); return *this; }
+            auto operator!=(const Iterator&) const noexcept -> bool { return !clipper->m_done; }
+        };
+
+        auto begin() -> Iterator
+        {
+            Start();
+            if (!NextRange()) { Finish(); }
+            return Iterator{this};
+        }
+
+        auto end() -> Iterator { return Iterator{this}; }
+
+        // End of the contiguous range of items the current one belongs to
+        auto GetRangeEnd() const noexcept -> int { return m_end; }
+
+        private:
+            struct Range
+            {
+                int begin;
+                int end;
+            };
+
+            void Start()
+            {
+                m_started = true;
+                if (m_offsets == nullptr)
+                {
+                    m_clipper.Begin(m_count, m_itemHeight);
+                    for (int i = 0; i < m_includedCount; ++i)
+                    {
+#if IMGUI_VERSION_NUM >= 18990
+                        m_clipper.IncludeItemsByIndex(m_included[i], m_included[i] + 1);
+#elif IMGUI_VERSION_NUM >= 18960
+                        m_clipper.IncludeRangeByIndices(m_included[i], m_included[i] + 1);
+#elif IMGUI_VERSION_NUM >= 18500
+                        m_clipper.ForceDisplayRangeByIndices(m_included[i], m_included[i] + 1);
+#else
+                        IM_ASSERT(false && "IncludeItemByIndex with uniform heights requires Dear ImGui 1.85+");
+#endif
+                    }
+                    return;
+                }
+
+                // Variable heights: binary search the clip rect in the offsets
+                m_origin = ImGui::GetCursorScreenPos();
+                const ImDrawList* drawList = ImGui::GetWindowDrawList();
+                const float top = drawList->GetClipRectMin().y - m_origin.y;
+                const float bottom = drawList->GetClipRectMax().y - m_origin.y;
+                const int first = UpperBound(top) - 1;
+                const int last = UpperBound(bottom);
+
+                m_rangeCount = 0;
+                AddRange(first > 0 ? first : 0, last < m_count ? last : m_count);
+                for (int i = 0; i < m_includedCount; ++i) { AddRange(m_included[i], m_included[i] + 1); }
+            }
+
+            // First index in [0, count] whose offset is greater than y
+            auto UpperBound(const float y) const noexcept -> int
+            {
+                int lo = 0, hi = m_count + 1;
+                while (lo < hi)
+                {
+                    const int mid = lo + (hi - lo) / 2;
+                    if (m_offsets[mid] <= y) { lo = mid + 1; }
+                    else                     { hi = mid; }
+                }
+                return lo;
+            }
+
+            // Keeps ranges sorted and merged
+            void AddRange(const int begin, const int end) noexcept
+            {
+                if (begin >= end) { return; }
+                int i = 0;
+                while (i < m_rangeCount && m_ranges[i].end < begin) { ++i; }
+                if (i < m_rangeCount && m_ranges[i].begin <= end)
+                {
+                    if (begin < m_ranges[i].begin) { m_ranges[i].begin = begin; }
+                    if (end > m_ranges[i].end) { m_ranges[i].end = end; }
+                    while (i + 1 < m_rangeCount && m_ranges[i + 1].begin <= m_ranges[i].end)
+                    {
+                        if (m_ranges[i + 1].end > m_ranges[i].end) { m_ranges[i].end = m_ranges[i + 1].end; }
+                        for (int j = i + 1; j + 1 < m_rangeCount; ++j) { m_ranges[j] = m_ranges[j + 1]; }
+                        --m_rangeCount;
+                    }
+                    return;
+                }
+                for (int j = m_rangeCount; j > i; --j) { m_ranges[j] = m_ranges[j - 1]; }
+                m_ranges[i].begin = begin;
+                m_ranges[i].end = end;
+                ++m_rangeCount;
+            }
+
+            auto NextRange() -> bool
+            {
+                if (m_offsets == nullptr)
+                {
+                    while (m_clipper.Step())
+                    {
+                        if (m_clipper.DisplayStart < m_clipper.DisplayEnd)
+                        {
+                            m_index = m_clipper.DisplayStart;
+                            m_end = m_clipper.DisplayEnd;
+                            return true;
+                        }
+                    }
+                    m_clipperDone = true; // Step() returning false already ended the clipper
+                    return false;
+                }
+
+                if (m_nextRange >= m_rangeCount) { return false; }
+                const Range& range = m_ranges[m_nextRange++];
+                m_index = range.begin;
+                m_end = range.end;
+                ImGui::SetCursorScreenPos(ImVec2(m_origin.x, m_origin.y + m_offsets[m_index]));
+                return true;
+            }
+
+            void Advance()
+            {
+                if (++m_index < m_end) { return; }
+                if (!NextRange()) { Finish(); }
+            }
+
+            void Finish()
+            {
+                m_done = true;
+                if (m_offsets == nullptr)
+                {
+                    if (!m_clipperDone) { m_clipper.End(); }
+                    return;
+                }
+
+                // Layout continues after the whole list, as if every item had been submitted
+                ImGui::SetCursorScreenPos(ImVec2(m_origin.x, m_origin.y + m_offsets[m_count]));
+                ImGui::Dummy(ImVec2(0.0f, 0.0f));
+            }
+
+            const int m_count;
+            const float m_itemHeight;
+            const float* const m_offsets;
+
+            ImGuiListClipper m_clipper;
+            bool m_started = false;
+            bool m_clipperDone = false;
+            bool m_done = false;
+            int m_index = 0;
+            int m_end = 0;
+
+            int m_included[MaxIncluded];
+            int m_includedCount = 0;
+
+            ImVec2 m_origin;
+            Range m_ranges[MaxIncluded + 1];
+            int m_rangeCount = 0;
+            int m_nextRange = 0;
+    };
+
+    // Range-for over the data rows of a table that are actually visible, each one already started with TableNextRow.
+    //
+    //   ImGui::TableSetupScrollFreeze(0, 1 + frozenRows);  // Headers row + pinned data rows
+    //   ImGui::TableHeadersRow();
+    //   for (int row : ImGuiSugar::TableClipper(count, frozenRows)) { ImGui::TableNextColumn(); ... }
+    //
+    // The first frozenRows data rows are always submitted (they stay pinned below the headers),
+    // the rest go through a clipper. Row indices are absolute, frozen rows included.
+    struct TableClipper
+    {
+        explicit TableClipper(const int count, const int frozenRows = 0, const float rowHeight = -1.0f,
+                              const ImGuiTableRowFlags rowFlags = 0) noexcept
+            : m_frozen(frozenRows < count ? (frozenRows > 0 ? frozenRows : 0) : count),
+              m_rowHeight(rowHeight), m_rowFlags(rowFlags), m_rows(count - m_frozen, rowHeight) {}
+
+        TableClipper(const TableClipper&) = delete;
+        TableClipper(TableClipper&&) = delete;
+        TableClipper& operator=(const TableClipper&) = delete; // NOLINT
+        TableClipper& operator=(TableClipper&&) = delete; // NOLINT
+
+        // Makes a non frozen row always submitted even if not visible. Call before iterating.
+        void IncludeRowByIndex(const int index) noexcept
+        {
+            if (index >= m_frozen) { m_rows.IncludeItemByIndex(index - m_frozen); }
+        }
+
+        struct Iterator
+        {
+            TableClipper* clipper;
+
+            auto operator*() const noexcept -> int { return clipper->m_index; }
+            auto operator++() -> Iterator& { clipper->Advance(); return *this; }
+            auto operator!=(const Iterator&) const noexcept -> bool { return !clipper->m_done; }
+        };
+
+        auto begin() -> Iterator
+        {
+            if (m_frozen > 0) { NextRow(); }
+            else              { StartClipper(); }
+            return Iterator{this};
+        }
+
+        auto end() -> Iterator { return Iterator{this}; }
+
+        // End of the contiguous range of rows the current one belongs to
+        auto GetRangeEnd() const noexcept -> int { return m_clipping ? m_frozen + m_rows.GetRangeEnd() : m_frozen; }
+
+        private:
+            void Advance()
+            {
+                if (m_index + 1 < m_frozen) { ++m_index; NextRow(); }
+                else if (!m_clipping)       { StartClipper(); }
+                else                        { ++m_it; Clipped(); }
+            }
+
+            // Clipping starts after the frozen rows, so the clipper sees the scrolling part of the table only
+            void StartClipper()
+            {
+                m_clipping = true;
+                m_it = m_rows.begin();
+                Clipped();
+            }
+
+            void Clipped()
+            {
+                if (m_it != m_rows.end()) { m_index = m_frozen + *m_it; NextRow(); }
+                else                      { m_done = true; }
+            }
+
+            void NextRow()
+            {
+                ImGui::TableNextRow(m_rowFlags, m_rowHeight > 0.0f ? m_rowHeight : 0.0f);
+            }
+
+            const int m_frozen;
+            const float m_rowHeight;
+            const ImGuiTableRowFlags m_rowFlags;
+
+            ListClipper m_rows;
+            ListClipper::Iterator m_it{nullptr};
+            bool m_clipping = false;
+            bool m_done = false;
+            int m_index = 0;
+    };
+
+    // Column lists of the TableVisibleColumns alive in a context, one per nesting level
+    // (a cell callback may show another table), reused from frame to frame
+    struct VisibleColumnLists
+    {
+        VisibleColumnLists() = default;
+        VisibleColumnLists(const VisibleColumnLists&) = delete;
+        VisibleColumnLists& operator=(const VisibleColumnLists&) = delete; // NOLINT
+
+        ~VisibleColumnLists()
+        {
+            for (ImVector<int>* list : lists) { IM_DELETE(list); }
+        }
+
+        ImVector<ImVector<int>*> lists;
+        int depth = 0;
+    };
+
+    // Visible columns of the current table (frozen columns included), gathered once, any column count.
+    // Must be created after the first row of the table has started, the layout is not known before.
+    struct TableVisibleColumns
+    {
+        TableVisibleColumns() : m_lists(GetContextLocal<VisibleColumnLists>())
+        {
+            if (m_lists.depth == m_lists.lists.Size) { m_lists.lists.push_back(IM_NEW(ImVector<int>)()); }
+            m_columns = m_lists.lists[m_lists.depth++];
+            m_columns->resize(0);
+
+            const int count = ImGui::TableGetColumnCount();
+            for (int column = 0; column < count; ++column)
+            {
+                if (ImGui::TableGetColumnFlags(column) & ImGuiTableColumnFlags_IsVisible) { m_columns->push_back(column); }
+            }
+        }
+
+        TableVisibleColumns(const TableVisibleColumns&) = delete;
+        TableVisibleColumns(TableVisibleColumns&&) = delete;
+        TableVisibleColumns& operator=(const TableVisibleColumns&) = delete; // NOLINT
+        TableVisibleColumns& operator=(TableVisibleColumns&&) = delete; // NOLINT
+
+        ~TableVisibleColumns() noexcept { --m_lists.depth; }
+
+        auto begin() const noexcept -> const int* { return m_columns->Data; }
+        auto end() const noexcept -> const int* { return m_columns->Data + m_columns->Size; }
+        auto size() const noexcept -> int { return m_columns->Size; }
+
+        private:
+            VisibleColumnLists& m_lists;
+            ImVector<int>* m_columns;
+    };
+
+    // Calls cell(row, column) only for the visible cells of the current table, with the cell already set
+    // as current. Rows are clipped as in TableClipper, columns scrolled out horizontally are skipped.
+    // Leading columns frozen with TableSetupScrollFreeze are always visible.
+    template<typename Cell>
+    void ForEachVisibleCell(const int rowCount, const int frozenRows, const float rowHeight, Cell&& cell)
+    {
+        TableClipper rows(rowCount, frozenRows, rowHeight);
+        TableClipper::Iterator it = rows.begin();
+        if (!(it != rows.end())) { return; }
+
+        const TableVisibleColumns columns; // The first row has started, so the layout is locked
+        for (; it != rows.end(); ++it)
+        {
+            const int row = *it;
+            for (const int column : columns)
+            {
+                ImGui::TableSetColumnIndex(column);
+                cell(row, column);
+            }
+        }
+    }
+
+    template<typename Cell>
+    void ForEachVisibleCell(const int rowCount, Cell&& cell)
+    {
+        ForEachVisibleCell(rowCount, 0, -1.0f, static_cast<Cell&&>(cell));
+    }
+
+    // Buffers reused by TableNumericCells, one per ImGui context, they only grow
+    struct NumericCellBatch
+    {
+        ImVector<char> text;
+        ImVector<int> offsets; // Begin of each cell in text, one extra for the end
+        ImVector<float> widths;
+        ImVector<float> columnWidths;
+    };
+
+    // Formats number at the end of text (not zero terminated), returns where it begins
+    inline auto AppendNumericCell(ImVector<char>& text, const Fixed& number) -> int
+    {
+        const int begin = text.Size;
+        text.resize(begin + static_cast<int>(PieceBound(number)));
+        char* out = text.Data + begin;
+        WritePiece(out, number);
+        text.resize(static_cast<int>(out - text.Data));
+        return begin;
+    }
+
+    // Batch of the current ImGui context
+    inline auto GetNumericCellBatch() -> NumericCellBatch&
+    {
+        return GetContextLocal<NumericCellBatch>();
+    }
+
+    // Numeric table cells: value(row, column) -> double printed right aligned with fixed decimals.
+    // Rows and columns are clipped as in ForEachVisibleCell. Each contiguous range of visible rows is
+    // formatted column by column into a reused buffer (no printf), widths come from the digit advances
+    // of the current font, and cells are emitted with TextUnformatted.
+    template<typename Value>
+    void TableNumericCells(const int rowCount, const int frozenRows, const int decimals, Value&& value)
+    {
+        TableClipper rows(rowCount, frozenRows);
+        TableClipper::Iterator it = rows.begin();
+        if (!(it != rows.end())) { return; }
+
+        const TableVisibleColumns columns;
+        NumericCellBatch& batch = GetNumericCellBatch();
+
+        // Advances of the characters numbers are made of, other ones (nan, inf) are measured
+        ImFont* font = ImGui::GetFont();
+        const float scale = ImGui::GetFontSize() / font->FontSize;
+        float advances[12];
+        for (int c = 0; c < 10; ++c) { advances[c] = font->GetCharAdvance(static_cast<ImWchar>('0' + c)) * scale; }
+        advances[10] = font->GetCharAdvance('.') * scale;
+        advances[11] = font->GetCharAdvance('-') * scale;
+
+        while (it != rows.end())
+        {
+            const int first = *it;
+            const int count = rows.GetRangeEnd() - first;
+
+            batch.text.resize(0);
+            batch.offsets.resize(0);
+            batch.widths.resize(0);
+            for (const int column : columns)
+            {
+                for (int row = first; row < first + count; ++row)
+                {
+                    const int begin = AppendNumericCell(batch.text, Fixed(value(row, column), decimals));
+                    const char* const out = batch.text.Data + batch.text.Size;
+
+                    float width = 0.0f;
+                    for (const char* c = batch.text.Data + begin; c != out; ++c)
+                    {
+                        if (*c >= '0' && *c <= '9') { width += advances[*c - '0']; }
+                        else if (*c == '.')         { width += advances[10]; }
+                        else if (*c == '-')         { width += advances[11]; }
+                        else                        { width = ImGui::CalcTextSize(batch.text.Data + begin, out).x; break; }
+                    }
+                    batch.offsets.push_back(begin);
+                    batch.widths.push_back(width);
+                }
+            }
+            batch.offsets.push_back(batch.text.Size);
+
+            batch.columnWidths.resize(columns.size());
+            for (int row = first; row < first + count; ++row, ++it)
+            {
+                for (int k = 0; k < columns.size(); ++k)
+                {
+                    ImGui::TableSetColumnIndex(*(columns.begin() + k));
+                    if (row == first) { batch.columnWidths[k] = ImGui::GetContentRegionAvail().x; } // Same for the whole column
+                    const int cell = k * count + (row - first);
+                    const float offset = batch.columnWidths[k] - batch.widths[cell];
+                    if (offset > 0.0f) { ImGui::SetCursorPosX(ImGui::GetCursorPosX() + offset); }
+                    ImGui::TextUnformatted(batch.text.Data + batch.offsets[cell], batch.text.Data + batch.offsets[cell + 1]);
+                }
+            }
+        }
+    }
+
+    template<typename Value>
+    void TableNumericCells(const int rowCount, const int decimals, Value&& value)
+    {
+        TableNumericCells(rowCount, 0, decimals, static_cast<Value&&>(value));
+    }
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+
+    // Hierarchy shown by FlatTree. Nodes are opaque handles (an index, a pointer cast to ImU64, ...).
+    struct TreeSource
+    {
+        virtual ~TreeSource() = default;
+
+        virtual auto GetChildCount(ImU64 node) -> int = 0;
+        virtual auto GetChild(ImU64 node, int index) -> ImU64 = 0;
+        virtual auto GetLabel(ImU64 node) -> const char* = 0; // Also the ID, as in with_TreeNode(label)
+        virtual auto GetFlags(ImU64 /*node*/) -> ImGuiTreeNodeFlags { return 0; }
+    };
+
+    // Flattened list of the visible (expanded) nodes below root, rebuilt incrementally when a node is
+    // opened or closed. Keep it alive across frames and draw it with FlatTreeClipper (with_FlatTree).
+    // IDs, open state and indentation are the same as nested with_TreeNode(label) scopes.
+    // Call Invalidate() when the structure of the source changes.
+    struct FlatTree
+    {
+        FlatTree(TreeSource& source, const ImU64 root) noexcept : m_source(source), m_root(root) {}
+
+        FlatTree(const FlatTree&) = delete;
+        FlatTree(FlatTree&&) = delete;
+        FlatTree& operator=(const FlatTree&) = delete; // NOLINT
+        FlatTree& operator=(FlatTree&&) = delete; // NOLINT
+
+        void Invalidate() noexcept { m_built = false; }
+
+        auto GetVisibleCount() const noexcept -> int { return m_rows.Size; }
+
+        private:
+            friend struct FlatTreeClipper;
+
+            struct Row
+            {
+                ImU64 node;
+                ImGuiID seed; // ID of the parent (the ID stack top while the parent is pushed)
+                ImGuiID id;
+                int depth;
+                bool leaf;
+                bool open;
+            };
+
+            // Called inside the window, open state lives in its storage
+            auto Prepare() -> int
+            {
+                const ImGuiID seed = ImGui::GetCurrentWindow()->IDStack.back();
+                if (!m_built || seed != m_seed)
+                {
+                    m_rows.resize(0);
+                    AppendChildren(m_root, seed, 0, m_rows);
+                    m_seed = seed;
+                    m_built = true;
+                }
+                m_toggled.resize(0);
+                return m_rows.Size;
+            }
+
+            void AppendChildren(const ImU64 parent, const ImGuiID seed, const int depth, ImVector<Row>& out)
+            {
+                const ImGuiStorage* storage = ImGui::GetStateStorage();
+                const int count = m_source.GetChildCount(parent);
+                for (int i = 0; i < count; ++i)
+                {
+                    Row row;
+                    row.node = m_source.GetChild(parent, i);
+                    row.seed = seed;
+                    row.id = ImHashStr(m_source.GetLabel(row.node), 0, seed);
+                    row.depth = depth;
+                    const ImGuiTreeNodeFlags flags = m_source.GetFlags(row.node);
+                    row.leaf = (flags & ImGuiTreeNodeFlags_Leaf) != 0 || m_source.GetChildCount(row.node) == 0;
+                    row.open = !row.leaf && storage->GetInt(row.id, (flags & ImGuiTreeNodeFlags_DefaultOpen) ? 1 : 0) != 0;
+                    out.push_back(row);
+                    if (row.open) { AppendChildren(row.node, row.id, depth + 1, out); }
+                }
+            }
+
+            // Toggled rows are spliced after drawing, from the last one so indices stay valid
+            void ApplyToggles()
+            {
+                const ImGuiStorage* storage = ImGui::GetStateStorage();
+                for (int t = m_toggled.Size - 1; t >= 0; --t)
+                {
+                    const int index = m_toggled[t];
+                    Row& row = m_rows[index];
+                    const bool open = storage->GetInt(row.id, 0) != 0;
+                    if (open == row.open) { continue; }
+                    row.open = open;
+                    if (open)
+                    {
+                        m_scratch.resize(0);
+                        AppendChildren(row.node, row.id, row.depth + 1, m_scratch);
+                        const int tail = m_rows.Size - (index + 1);
+                        m_rows.resize(m_rows.Size + m_scratch.Size);
+                        memmove(m_rows.Data + index + 1 + m_scratch.Size, m_rows.Data + index + 1, sizeof(Row) * tail);
+                        memcpy(m_rows.Data + index + 1, m_scratch.Data, sizeof(Row) * m_scratch.Size);
+                    }
+                    else
+                    {
+                        const int depth = m_rows[index].depth;
+                        int last = index + 1;
+                        while (last < m_rows.Size && m_rows[last].depth > depth) { ++last; }
+                        m_rows.erase(m_rows.Data + index + 1, m_rows.Data + last);
+                    }
+                }
+                m_toggled.resize(0);
+            }
+
+            TreeSource& m_source;
+            const ImU64 m_root;
+            ImVector<Row> m_rows;
+            ImVector<Row> m_scratch;
+            ImVector<int> m_toggled;
+            ImGuiID m_seed = 0;
+            bool m_built = false;
+    };
+
+    // Range-for over the visible nodes of a FlatTree, each one already drawn as a tree node.
+    // The loop body runs with the node ID pushed, like the body of with_TreeNode, but for every
+    // visible row (open or not) so it can add more items on the same line.
+    struct FlatTreeClipper
+    {
+        explicit FlatTreeClipper(FlatTree& tree) : m_tree(tree), m_clipper(tree.Prepare()) {}
+
+        FlatTreeClipper(const FlatTreeClipper&) = delete;
+        FlatTreeClipper(FlatTreeClipper&&) = delete;
+        FlatTreeClipper& operator=(const FlatTreeClipper&) = delete; // NOLINT
+        FlatTreeClipper& operator=(FlatTreeClipper&&) = delete; // NOLINT
+
+        ~FlatTreeClipper()
+        {
+            if (m_started && !m_done) { EndRow(); Finish(); }
+        }
+
+        struct Iterator
+        {
+            FlatTreeClipper* clipper;
+
+            auto operator*() const noexcept -> ImU64 { return clipper->m_node; }
+            auto operator++() -> Iterator& { clipper->Advance(); return *this; }
+            auto operator!=(const Iterator&) const noexcept -> bool { return !clipper->m_done; }
+        };
+
+        auto begin() -> Iterator
+        {
+            m_started = true;
+            m_indentSpacing = ImGui::GetStyle().IndentSpacing;
+            m_it = m_clipper.begin();
+            Visit();
+            return Iterator{this};
+        }
+
+        auto end() -> Iterator { return Iterator{this}; }
+
+        private:
+            void Advance()
+            {
+                EndRow();
+                ++m_it;
+                Visit();
+            }
+
+            void Visit()
+            {
+                if (m_it != m_clipper.end()) { BeginRow(*m_it); }
+                else                         { Finish(); }
+            }
+
+            void BeginRow(const int index)
+            {
+                const FlatTree::Row& row = m_tree.m_rows[index];
+                if (row.depth > m_depth)      { ImGui::Indent(m_indentSpacing * static_cast<float>(row.depth - m_depth)); }
+                else if (row.depth < m_depth) { ImGui::Unindent(m_indentSpacing * static_cast<float>(m_depth - row.depth)); }
+                m_depth = row.depth;
+
+                TreeSource& source = m_tree.m_source;
+                ImGuiTreeNodeFlags flags = source.GetFlags(row.node) | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+                if (row.leaf) { flags |= ImGuiTreeNodeFlags_Leaf; }
+
+                ImGui::PushOverrideID(row.seed);
+                ImGui::TreeNodeEx(source.GetLabel(row.node), flags);
+                if (ImGui::IsItemToggledOpen()) { m_tree.m_toggled.push_back(index); }
+                ImGui::PopID();
+
+                ImGui::PushOverrideID(row.id);
+                m_node = row.node;
+                m_inRow = true;
+            }
+
+            void EndRow()
+            {
+                if (m_inRow) { ImGui::PopID(); m_inRow = false; }
+            }
+
+            void Finish()
+            {
+                m_done = true;
+                if (m_depth > 0) { ImGui::Unindent(m_indentSpacing * static_cast<float>(m_depth)); }
+                m_tree.ApplyToggles();
+            }
+
+            FlatTree& m_tree;
+            ListClipper m_clipper;
+            ListClipper::Iterator m_it{nullptr};
+            float m_indentSpacing = 0.0f;
+            ImU64 m_node = 0;
+            int m_depth = 0;
+            bool m_inRow = false;
+            bool m_started = false;
+            bool m_done = false;
+    };
+
+#endif // IMGUI_SUGAR_ENABLE_INTERNAL
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Draw list caching
+// ----------------------------------------------------------------------------
+
+namespace ImGuiSugar
+{
+    // Geometry recorded from a with_CachedRegion body, replayed while its inputs are unchanged
+    struct CachedRegion
+    {
+        ImU64 hash = 0;
+        ImVec2 origin;
+        ImVec2 size;
+        ImVec4 clipRect;       // Relative to origin, coarse clipping depends on it
+        ImTextureID textureId = ImTextureID();
+        ImVector<ImDrawVert> vertices;
+        ImVector<ImDrawIdx> indices; // Relative to the first vertex
+        bool valid = false;
+    };
+
+    // Heap allocated entries looked up by ID, owned until Clear()
+    template<typename T>
+    struct SlotRegistry
+    {
+        ImGuiStorage byId;
+        ImVector<T*> slots;
+
+        SlotRegistry() = default;
+        SlotRegistry(const SlotRegistry&) = delete;
+        SlotRegistry& operator=(const SlotRegistry&) = delete; // NOLINT
+
+        ~SlotRegistry() { Clear(); }
+
+        auto Get(const ImGuiID id) -> T&
+        {
+            T* slot = static_cast<T*>(byId.GetVoidPtr(id));
+            if (slot == nullptr)
+            {
+                slot = IM_NEW(T)();
+                slots.push_back(slot);
+                byId.SetVoidPtr(id, slot);
+            }
+            return *slot;
+        }
+
+        void Clear()
+        {
+            for (T* slot : slots) { IM_DELETE(slot); }
+            slots.clear();
+            byId.Clear();
+        }
+    };
+
+    inline auto GetCachedRegionRegistry() -> SlotRegistry<CachedRegion>&
+    {
+        static SlotRegistry<CachedRegion> registry;
+        return registry;
+    }
+
+    inline auto GetCachedRegion(const ImGuiID id) -> CachedRegion&
+    {
+        return GetCachedRegionRegistry().Get(id);
+    }
+
+    // Frees all recorded regions (e.g. after a font atlas rebuild, or before destroying the context)
+    inline void ClearCachedRegions()
+    {
+        GetCachedRegionRegistry().Clear();
+    }
+
+    // Appends recorded geometry (indices relative to its first vertex) translated by delta
+    inline void AppendGeometry(ImDrawList* drawList, const ImVector<ImDrawVert>& vertices, const ImVector<ImDrawIdx>& indices, const ImVec2& delta)
+    {
+        const int vtxCount = vertices.Size;
+        const int idxCount = indices.Size;
+        if (idxCount == 0) { return; }
+
+        drawList->PrimReserve(idxCount, vtxCount);
+        ImDrawVert* vtx = drawList->_VtxWritePtr;
+        for (int i = 0; i < vtxCount; ++i)
+        {
+            vtx[i] = vertices[i];
+            vtx[i].pos.x += delta.x;
+            vtx[i].pos.y += delta.y;
+        }
+        const unsigned int base = drawList->_VtxCurrentIdx;
+        ImDrawIdx* idx = drawList->_IdxWritePtr;
+        for (int i = 0; i < idxCount; ++i) { idx[i] = static_cast<ImDrawIdx>(base + indices[i]); }
+        drawList->_VtxWritePtr += vtxCount;
+        drawList->_IdxWritePtr += idxCount;
+        drawList->_VtxCurrentIdx += static_cast<unsigned int>(vtxCount);
+    }
+
+    // Runs the body (recording its draw list output) when the region is new, its hash changed,
+    // or its clip rect or texture differ. Otherwise the body is skipped, the recorded geometry is
+    // appended again (translated if the origin moved) and a Dummy keeps the layout.
+    //
+    // Items in a skipped body do not exist for that frame. Keep interactive items out of cached
+    // regions, or pass interactive = true to run the body whenever the region is hovered or any
+    // item is active. A body that changes the clip rect or texture is never cached.
+    struct CachedRegionGuard
+    {
+        // Any integer hash, so with_CachedRegion(key, intValue) is not a narrowing error
+        template<typename Hash, typename std::enable_if<std::is_integral<Hash>::value, int>::type = 0>
+        CachedRegionGuard(const char* key, const Hash hash, const bool interactive = false)
+            : CachedRegionGuard(key, static_cast<ImU64>(hash), interactive) {}
+
+        CachedRegionGuard(const char* key, const ImU64 hash, const bool interactive = false)
+            : m_drawList(ImGui::GetWindowDrawList()), m_region(GetCachedRegion(ImGui::GetID(key))),
+              m_hash(hash), m_origin(ImGui::GetCursorScreenPos()), m_clipRect(RelativeClipRect())
+        {
+            const CachedRegion& region = m_region;
+            const bool reusable = region.valid && region.hash == hash && region.textureId == m_drawList->_CmdHeader.TextureId
+                && region.clipRect.x == m_clipRect.x && region.clipRect.y == m_clipRect.y
+                && region.clipRect.z == m_clipRect.z && region.clipRect.w == m_clipRect.w;
+            const bool live = interactive && reusable
+                && (ImGui::IsAnyItemActive()
+                    || ImGui::IsMouseHoveringRect(m_origin, ImVec2(m_origin.x + region.size.x, m_origin.y + region.size.y)));
+
+            if (reusable && !live) { Replay(); }
+            else                   { StartRecording(); }
+        }
+
+        CachedRegionGuard(const CachedRegionGuard&) = delete;
+        CachedRegionGuard(CachedRegionGuard&&) = delete;
+        CachedRegionGuard& operator=(const CachedRegionGuard&) = delete; // NOLINT
+        CachedRegionGuard& operator=(CachedRegionGuard&&) = delete; // NOLINT
+
+        ~CachedRegionGuard()
+        {
+            if (m_recording)
+            {
+                ImGui::EndGroup();
+                Record();
+            }
+        }
+
+        operator bool() const & noexcept { return m_recording; } // (Implicit) NOLINT
+
+        protected:
+            // Unconditional modes for LowPriorityGuard: always run and record, or replay the last
+            // recording whatever the inputs (only its layout if the texture changed or the body
+            // could not be recorded)
+            enum class Mode { Record, Replay };
+
+            CachedRegionGuard(const char* key, const Mode mode)
+                : m_drawList(ImGui::GetWindowDrawList()), m_region(GetCachedRegion(ImGui::GetID(key))),
+                  m_hash(0), m_origin(ImGui::GetCursorScreenPos()), m_clipRect(RelativeClipRect())
+            {
+                const CachedRegion& region = m_region;
+                if (mode == Mode::Record)                                                      { StartRecording(); }
+                else if (region.valid && region.textureId == m_drawList->_CmdHeader.TextureId) { Replay(); }
+                else                                                                           { ImGui::Dummy(region.size); }
+            }
+
+        private:
+            auto RelativeClipRect() const -> ImVec4
+            {
+                const ImVec2 clipMin = m_drawList->GetClipRectMin();
+                const ImVec2 clipMax = m_drawList->GetClipRectMax();
+                return ImVec4(clipMin.x - m_origin.x, clipMin.y - m_origin.y, clipMax.x - m_origin.x, clipMax.y - m_origin.y);
+            }
+
+            void StartRecording()
+            {
+                m_recording = true;
+                m_header = m_drawList->_CmdHeader;
+                m_cmdCount = m_drawList->CmdBuffer.Size;
+                m_vtxStart = m_drawList->VtxBuffer.Size;
+                m_idxStart = m_drawList->IdxBuffer.Size;
+                m_vtxBase = m_drawList->_VtxCurrentIdx;
+                ImGui::BeginGroup();
+            }
+
+            void Record()
+            {
+                CachedRegion& region = m_region;
+                const ImDrawCmdHeader& header = m_drawList->_CmdHeader;
+                region.size = ImGui::GetItemRectSize(); // Also kept for bodies that cannot be replayed
+                region.valid = m_drawList->CmdBuffer.Size == m_cmdCount
+                    && memcmp(&header, &m_header, sizeof(ImDrawCmdHeader)) == 0;
+                if (!region.valid) { return; } // Several draw commands, always run the body
+
+                region.hash = m_hash;
+                region.origin = m_origin;
+                region.clipRect = m_clipRect;
+                region.textureId = header.TextureId;
+
+                const int vtxCount = m_drawList->VtxBuffer.Size - m_vtxStart;
+                const int idxCount = m_drawList->IdxBuffer.Size - m_idxStart;
+                region.vertices.resize(vtxCount);
+                region.indices.resize(idxCount);
+                if (vtxCount > 0) { memcpy(region.vertices.Data, m_drawList->VtxBuffer.Data + m_vtxStart, sizeof(ImDrawVert) * vtxCount); }
+                for (int i = 0; i < idxCount; ++i)
+                {
+                    region.indices[i] = static_cast<ImDrawIdx>(m_drawList->IdxBuffer[m_idxStart + i] - m_vtxBase);
+                }
+            }
+
+            void Replay()
+            {
+                const CachedRegion& region = m_region;
+                AppendGeometry(m_drawList, region.vertices, region.indices, ImVec2(m_origin.x - region.origin.x, m_origin.y - region.origin.y));
+                ImGui::Dummy(region.size);
+            }
+
+            ImDrawList* const m_drawList;
+            CachedRegion& m_region;
+            const ImU64 m_hash;
+            const ImVec2 m_origin;
+            const ImVec4 m_clipRect;
+            ImDrawCmdHeader m_header;
+            int m_cmdCount = 0;
+            int m_vtxStart = 0;
+            int m_idxStart = 0;
+            unsigned int m_vtxBase = 0;
+            bool m_recording = false;
+    };
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Wrapped text layouts (IMGUI_SUGAR_ENABLE_INTERNAL)
+// ----------------------------------------------------------------------------
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+
+// Frames a wrapped text layout is kept without being drawn before it is freed
+#ifndef IMGUI_SUGAR_TEXT_LAYOUT_MAX_AGE
+#define IMGUI_SUGAR_TEXT_LAYOUT_MAX_AGE 600
+#endif
+
+namespace ImGuiSugar
+{
+    // Line breaks of a wrapped text, valid while its key (buffer, font, size, wrap width) is unchanged
+    struct TextLayout
+    {
+        struct Line
+        {
+            int begin = 0;             // Byte offsets into the text
+            int end = 0;
+            float width = 0.0f;
+        };
+
+        const char* text = nullptr;
+        int length = -1;
+        const ImFont* font = nullptr;
+        float fontSize = 0.0f;
+        float wrapWidth = 0.0f;
+        ImU64 version = 0;
+        float width = 0.0f;            // Widest line
+        ImVector<Line> lines;
+        ImGuiID id = 0;
+        int lastFrame = 0;             // Last frame drawn, for eviction
+
+        auto Matches(const char* text_, const int length_, const ImFont* font_, const float fontSize_, const float wrapWidth_, const ImU64 version_) const -> bool
+        {
+            return text == text_ && length == length_ && font == font_ && fontSize == fontSize_ && wrapWidth == wrapWidth_ && version == version_;
+        }
+
+        // Same breaks as ImFont::RenderText: paragraphs end at '\n', lines wrap at
+        // CalcWordWrapPositionA and blanks after a wrap are skipped
+        void Build(const char* text_, const int length_, const ImFont* font_, const float fontSize_, const float wrapWidth_, const ImU64 version_)
+        {
+            text = text_;
+            length = length_;
+            font = font_;
+            fontSize = fontSize_;
+            wrapWidth = wrapWidth_;
+            version = version_;
+            width = 0.0f;
+            lines.resize(0);
+
+            const float scale = fontSize / font->FontSize;
+            const char* const end = text + length;
+            const char* s = text;
+            while (s < end)
+            {
+                const char* paragraphEnd = static_cast<const char*>(memchr(s, '\n', static_cast<size_t>(end - s)));
+                if (paragraphEnd == nullptr) { paragraphEnd = end; }
+                do
+                {
+                    const char* eol = wrapWidth > 0.0f ? font->CalcWordWrapPositionA(scale, s, paragraphEnd, wrapWidth) : paragraphEnd;
+                    if (eol == s && s < paragraphEnd) { ++eol; }
+
+                    Line line;
+                    line.begin = static_cast<int>(s - text);
+                    line.end = static_cast<int>(eol - text);
+                    line.width = font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, s, eol).x;
+                    width = line.width > width ? line.width : width;
+                    lines.push_back(line);
+
+                    s = eol;
+                    while (s < paragraphEnd && (*s == ' ' || *s == '\t')) { ++s; }
+                } while (s < paragraphEnd);
+                s = paragraphEnd + 1;
+            }
+        }
+    };
+
+    // Layouts looked up by ID. The ones not drawn for IMGUI_SUGAR_TEXT_LAYOUT_MAX_AGE frames
+    // are freed on the first lookup of a frame.
+    struct TextLayoutCache
+    {
+        TextLayoutCache() = default;
+        TextLayoutCache(const TextLayoutCache&) = delete;
+        TextLayoutCache& operator=(const TextLayoutCache&) = delete; // NOLINT
+
+        ~TextLayoutCache() { Clear(); }
+
+        auto Get(const ImGuiID id) -> TextLayout&
+        {
+            const int frame = ImGui::GetFrameCount();
+            if (frame != m_frame)
+            {
+                m_frame = frame;
+                EvictUnused(frame);
+            }
+
+            TextLayout* layout = static_cast<TextLayout*>(m_byId.GetVoidPtr(id));
+            if (layout == nullptr)
+            {
+                layout = IM_NEW(TextLayout)();
+                layout->id = id;
+                m_layouts.push_back(layout);
+                m_byId.SetVoidPtr(id, layout);
+            }
+            layout->lastFrame = frame;
+            return *layout;
+        }
+
+        auto Size() const noexcept -> int { return m_layouts.Size; }
+
+        void Clear()
+        {
+            for (TextLayout* layout : m_layouts) { IM_DELETE(layout); }
+            m_layouts.clear();
+            m_byId.Clear();
+        }
+
+        private:
+            void EvictUnused(const int frame)
+            {
+                int kept = 0;
+                for (int i = 0; i < m_layouts.Size; ++i)
+                {
+                    TextLayout* layout = m_layouts[i];
+                    if (frame - layout->lastFrame > IMGUI_SUGAR_TEXT_LAYOUT_MAX_AGE) { IM_DELETE(layout); }
+                    else                                                             { m_layouts[kept++] = layout; }
+                }
+                if (kept == m_layouts.Size) { return; }
+
+                // ImGuiStorage cannot erase keys, rebuild it from the kept layouts
+                m_layouts.resize(kept);
+                m_byId.Clear();
+                for (TextLayout* layout : m_layouts) { m_byId.SetVoidPtr(layout->id, layout); }
+            }
+
+            ImGuiStorage m_byId;
+            ImVector<TextLayout*> m_layouts;
+            int m_frame = -1;
+    };
+
+    inline auto GetTextLayoutCache() -> TextLayoutCache&
+    {
+        static TextLayoutCache cache;
+        return cache;
+    }
+
+    // Frees all layouts (e.g. when large texts are released)
+    inline void ClearTextLayouts()
+    {
+        GetTextLayoutCache().Clear();
+    }
+
+    // TextWrapped for large, rarely changing texts: line breaks are computed once per
+    // (buffer, font, size, wrap width) and only the lines intersecting the clip rect are drawn.
+    // Wraps at the with_TextWrapPos position, or at the content region edge outside of one.
+    // The layout is kept under id (one per text shown) while it is drawn: pass a new version
+    // when the contents of the same buffer change.
+    inline void TextWrappedCached(const ImGuiID id, const char* text, const char* textEnd = nullptr, const ImU64 version = 0)
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if (window->SkipItems) { return; }
+        if (textEnd == nullptr) { textEnd = text + strlen(text); }
+
+        const ImVec2 pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset); // As ImGui::TextEx
+        const float wrapPosX = window->DC.TextWrapPos < 0.0f ? 0.0f : window->DC.TextWrapPos;
+        const float wrapWidth = ImGui::CalcWrapWidthForPos(window->DC.CursorPos, wrapPosX);
+        ImFont* font = ImGui::GetFont();
+        const float fontSize = ImGui::GetFontSize();
+        const int length = static_cast<int>(textEnd - text);
+
+        TextLayout& layout = GetTextLayoutCache().Get(id);
+        if (!layout.Matches(text, length, font, fontSize, wrapWidth, version))
+        {
+            layout.Build(text, length, font, fontSize, wrapWidth, version);
+        }
+
+        const int lineCount = layout.lines.Size > 0 ? layout.lines.Size : 1;
+        const float lineHeight = fontSize;
+        ImDrawList* drawList = window->DrawList;
+        const float clipMinY = drawList->GetClipRectMin().y;
+        const float clipMaxY = drawList->GetClipRectMax().y;
+        int first = static_cast<int>((clipMinY - pos.y) / lineHeight);
+        int last = static_cast<int>((clipMaxY - pos.y) / lineHeight) + 1;
+        first = first < 0 ? 0 : first;
+        last = last > layout.lines.Size ? layout.lines.Size : last;
+
+        const ImU32 color = ImGui::GetColorU32(ImGuiCol_Text);
+        for (int i = first; i < last; ++i)
+        {
+            const TextLayout::Line& line = layout.lines[i];
+            if (line.end == line.begin) { continue; }
+            drawList->AddText(font, fontSize, ImVec2(pos.x, pos.y + lineHeight * static_cast<float>(i)), color, text + line.begin, text + line.end);
+        }
+
+        const ImVec2 size(layout.width, lineHeight * static_cast<float>(lineCount));
+        ImGui::ItemSize(size, 0.0f);
+        ImGui::ItemAdd(ImRect(pos, ImVec2(pos.x + size.x, pos.y + size.y)), 0);
+    }
+
+    // Same, with the layout kept under ImGui::GetID(strId)
+    inline void TextWrappedCached(const char* strId, const char* text, const char* textEnd = nullptr, const ImU64 version = 0)
+    {
+        TextWrappedCached(ImGui::GetID(strId), text, textEnd, version);
+    }
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_ENABLE_INTERNAL
+
+// ----------------------------------------------------------------------------
+// [SECTION] Glyph runs (IMGUI_SUGAR_ENABLE_INTERNAL)
+// ----------------------------------------------------------------------------
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+
+// Maximum number of cached glyph runs, the least recently used one is rebuilt for a new text
+#ifndef IMGUI_SUGAR_GLYPH_RUN_CAPACITY
+#define IMGUI_SUGAR_GLYPH_RUN_CAPACITY 2048
+#endif
+
+namespace ImGuiSugar
+{
+    // Geometry of a text drawn at (0, 0) with a given font, size and color
+    struct GlyphRun
+    {
+        ImGuiID id = 0;
+        ImVector<char> text;
+        const ImFont* font = nullptr;
+        float fontSize = 0.0f;
+        ImU32 color = 0;
+        ImVec2 size;
+        ImVector<ImDrawVert> vertices;
+        ImVector<ImDrawIdx> indices; // Relative to the first vertex
+        bool valid = false;            // Otherwise drawn with AddText
+
+        // Atlas the run was built from: texture, size and white pixel UV, cache generation
+        ImTextureID textureId = ImTextureID();
+        int texWidth = 0;
+        int texHeight = 0;
+        ImVec2 texUvWhitePixel;
+        int generation = -1;
+
+        GlyphRun* prev = nullptr;      // Recency list, most recently used first
+        GlyphRun* next = nullptr;
+
+        auto Matches(const char* text_, const int length, const ImFont* font_, const float fontSize_, const ImU32 color_) const -> bool
+        {
+            return font == font_ && fontSize == fontSize_ && color == color_
+                && text.Size == length && memcmp(text.Data, text_, static_cast<size_t>(length)) == 0;
+        }
+
+        // Whether the glyph positions and UVs of the run are still the ones of the atlas
+        auto BuiltFrom(const ImFontAtlas* atlas, const int generation_) const -> bool
+        {
+            if (generation != generation_ || textureId != atlas->TexID) { return false; }
+            return texWidth == atlas->TexWidth && texHeight == atlas->TexHeight
+                && texUvWhitePixel.x == atlas->TexUvWhitePixel.x && texUvWhitePixel.y == atlas->TexUvWhitePixel.y;
+        }
+    };
+
+    // Bounded LRU cache of glyph runs, looked up by a hash of the text, font, size and color.
+    // A run is rebuilt when the atlas texture ID, size or white pixel changed since it was
+    // built, or when Invalidate() was called after it.
+    struct GlyphRunCache
+    {
+        GlyphRunCache() = default;
+        GlyphRunCache(const GlyphRunCache&) = delete;
+        GlyphRunCache& operator=(const GlyphRunCache&) = delete; // NOLINT
+
+        ~GlyphRunCache()
+        {
+            Clear();
+            if (m_scratch != nullptr) { IM_DELETE(m_scratch); }
+        }
+
+        auto Get(const char* text, const char* textEnd, const ImFont* font, const float fontSize, const ImU32 color) -> const GlyphRun&
+        {
+            const int length = static_cast<int>(textEnd - text);
+            ImGuiID seed = ImHashData(&font, sizeof(font), color);
+            seed = ImHashData(&fontSize, sizeof(fontSize), seed);
+            const ImGuiID id = ImHashData(text, static_cast<size_t>(length), seed);
+
+            GlyphRun* run = static_cast<GlyphRun*>(m_byId.GetVoidPtr(id));
+            if (run == nullptr)
+            {
+                if (m_count < IMGUI_SUGAR_GLYPH_RUN_CAPACITY)
+                {
+                    run = IM_NEW(GlyphRun)();
+                    ++m_count;
+                }
+                else
+                {
+                    run = m_last;
+                    Unlink(run);
+                    m_byId.SetVoidPtr(run->id, nullptr);
+                }
+                run->font = nullptr; // Forces a build
+                Rekey(run, id);
+            }
+            else
+            {
+                Unlink(run);
+            }
+            PushFront(run);
+
+            if (!run->Matches(text, length, font, fontSize, color) || !run->BuiltFrom(font->ContainerAtlas, m_generation))
+            {
+                Build(*run, text, length, font, fontSize, color);
+            }
+            return *run;
+        }
+
+        // Rebuilds every run on its next use, keeping the memory
+        void Invalidate() noexcept { ++m_generation; }
+
+        void Clear()
+        {
+            while (m_first != nullptr)
+            {
+                GlyphRun* run = m_first;
+                Unlink(run);
+                IM_DELETE(run);
+            }
+            m_byId.Clear();
+            m_count = 0;
+            m_keys = 0;
+        }
+
+        private:
+            void Rekey(GlyphRun* run, const ImGuiID id)
+            {
+                run->id = id;
+                m_byId.SetVoidPtr(id, run);
+                // Evicted keys stay in the storage, compact it once they dominate
+                if (++m_keys > 4 * IMGUI_SUGAR_GLYPH_RUN_CAPACITY)
+                {
+                    m_byId.Clear();
+                    for (GlyphRun* it = m_first; it != nullptr; it = it->next) { m_byId.SetVoidPtr(it->id, it); }
+                    m_byId.SetVoidPtr(id, run);
+                    m_keys = m_count;
+                }
+            }
+
+            void Unlink(GlyphRun* run)
+            {
+                if (run->prev != nullptr) { run->prev->next = run->next; } else if (m_first == run) { m_first = run->next; }
+                if (run->next != nullptr) { run->next->prev = run->prev; } else if (m_last == run)  { m_last = run->prev; }
+                run->prev = nullptr;
+                run->next = nullptr;
+            }
+
+            void PushFront(GlyphRun* run)
+            {
+                run->next = m_first;
+                if (m_first != nullptr) { m_first->prev = run; }
+                m_first = run;
+                if (m_last == nullptr) { m_last = run; }
+            }
+
+            // Draws the text at (0, 0) in a private draw list, without clipping
+            void Build(GlyphRun& run, const char* text, const int length, const ImFont* font, const float fontSize, const ImU32 color)
+            {
+                const ImFontAtlas* atlas = font->ContainerAtlas;
+                run.text.resize(length);
+                if (length > 0) { memcpy(run.text.Data, text, static_cast<size_t>(length)); }
+                run.font = font;
+                run.fontSize = fontSize;
+                run.color = color;
+                run.textureId = atlas->TexID;
+                run.texWidth = atlas->TexWidth;
+                run.texHeight = atlas->TexHeight;
+                run.texUvWhitePixel = atlas->TexUvWhitePixel;
+                run.generation = m_generation;
+
+                const ImVec2 size = font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, text, text + length);
+                run.size = ImVec2(ImFloor(size.x + 0.95f), size.y); // As ImGui::CalcTextSize
+
+                const ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+                if (m_scratch == nullptr || m_scratch->_Data != shared)
+                {
+                    if (m_scratch != nullptr) { IM_DELETE(m_scratch); }
+                    m_scratch = IM_NEW(ImDrawList)(shared);
+                }
+                ImDrawList& scratch = *m_scratch;
+                scratch._ResetForNewFrame();
+                scratch.PushClipRect(ImVec2(-FLT_MAX, -FLT_MAX), ImVec2(FLT_MAX, FLT_MAX));
+                scratch.PushTextureID(atlas->TexID);
+                scratch.AddText(font, fontSize, ImVec2(0.0f, 0.0f), color, text, text + length);
+
+                run.valid = scratch.CmdBuffer.Size == 1; // Vertex offsets were split for a very long text
+                run.vertices.resize(run.valid ? scratch.VtxBuffer.Size : 0);
+                run.indices.resize(run.valid ? scratch.IdxBuffer.Size : 0);
+                if (run.vertices.Size > 0) { memcpy(run.vertices.Data, scratch.VtxBuffer.Data, sizeof(ImDrawVert) * run.vertices.Size); }
+                if (run.indices.Size > 0)  { memcpy(run.indices.Data, scratch.IdxBuffer.Data, sizeof(ImDrawIdx) * run.indices.Size); }
+                scratch.PopTextureID();
+                scratch.PopClipRect();
+            }
+
+            ImGuiStorage m_byId;
+            GlyphRun* m_first = nullptr;
+            GlyphRun* m_last = nullptr;
+            int m_count = 0;
+            int m_keys = 0;                // Keys set in m_byId, evicted ones included
+            int m_generation = 0;
+            ImDrawList* m_scratch = nullptr;
+    };
+
+    inline auto GetGlyphRunCache() -> GlyphRunCache&
+    {
+        static GlyphRunCache cache;
+        return cache;
+    }
+
+    // Frees all glyph runs
+    inline void ClearGlyphRuns()
+    {
+        GetGlyphRunCache().Clear();
+    }
+
+    // Rebuilds all glyph runs on their next use. Runs are checked against the texture ID, size
+    // and white pixel of the atlas, call this after a rebuild keeping all three.
+    inline void InvalidateGlyphRuns()
+    {
+        GetGlyphRunCache().Invalidate();
+    }
+
+    // Copies the run translated to pos (rounded like ImFont::RenderText)
+    inline void AddGlyphRun(ImDrawList* drawList, const ImVec2& pos, const GlyphRun& run)
+    {
+        if (!run.valid || run.textureId != drawList->_CmdHeader.TextureId)
+        {
+            drawList->AddText(run.font, run.fontSize, pos, run.color, run.text.Data, run.text.Data + run.text.Size);
+            return;
+        }
+        AppendGeometry(drawList, run.vertices, run.indices, ImVec2(ImFloor(pos.x), ImFloor(pos.y)));
+    }
+
+    // ImDrawList::AddText with the current font and font size, from a cached glyph run:
+    // no glyph lookups or UTF-8 decoding once the run is built
+    inline void AddTextCached(ImDrawList* drawList, const ImVec2& pos, const ImU32 color, const char* text, const char* textEnd = nullptr)
+    {
+        if ((color & IM_COL32_A_MASK) == 0) { return; }
+        if (textEnd == nullptr) { textEnd = text + strlen(text); }
+        AddGlyphRun(drawList, pos, GetGlyphRunCache().Get(text, textEnd, ImGui::GetFont(), ImGui::GetFontSize(), color));
+    }
+
+    // TextUnformatted for short labels drawn every frame ("OK", units, column captions).
+    // A text wider than the with_TextWrapPos width is wrapped by ImGui::TextUnformatted instead.
+    inline void TextCached(const char* text, const char* textEnd = nullptr)
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if (window->SkipItems) { return; }
+        if (textEnd == nullptr) { textEnd = text + strlen(text); }
+
+        const GlyphRun& run = GetGlyphRunCache().Get(text, textEnd, ImGui::GetFont(), ImGui::GetFontSize(), ImGui::GetColorU32(ImGuiCol_Text));
+        if (window->DC.TextWrapPos >= 0.0f && run.size.x > ImGui::CalcWrapWidthForPos(window->DC.CursorPos, window->DC.TextWrapPos))
+        {
+            ImGui::TextUnformatted(text, textEnd);
+            return;
+        }
+
+        const ImVec2 pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset); // As ImGui::TextEx
+        ImGui::ItemSize(run.size, 0.0f);
+        if (!ImGui::ItemAdd(ImRect(pos, ImVec2(pos.x + run.size.x, pos.y + run.size.y)), 0)) { return; }
+        AddGlyphRun(window->DrawList, pos, run);
+    }
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_ENABLE_INTERNAL
+
+// ----------------------------------------------------------------------------
+// [SECTION] Frame time budgets
+// ----------------------------------------------------------------------------
+
+// Monotonic clock in nanoseconds (steady_clock is clock_gettime(CLOCK_MONOTONIC) on Linux).
+// Can be replaced by a TSC based clock.
+#ifndef IMGUI_SUGAR_CLOCK_NS
+#define IMGUI_SUGAR_CLOCK_NS() static_cast<ImU64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())
+#endif
+
+namespace ImGuiSugar
+{
+    struct BudgetGuard;
+
+    // Innermost budget of the calling thread (budgets form a chain through the guards on the stack)
+    inline auto CurrentBudget() noexcept -> const BudgetGuard*&
+    {
+        static thread_local const BudgetGuard* current = nullptr;
+        return current;
+    }
+
+    // Time budget for a scope. The body always runs, low priority children (with_LowPriority) check
+    // IsOverBudget() and degrade once the budget, or any enclosing one, is spent.
+    struct BudgetGuard
+    {
+        // Any integer type, so with_Budget(intValue) is not a narrowing error. Negative = exhausted.
+        template<typename Microseconds, typename std::enable_if<std::is_integral<Microseconds>::value, int>::type = 0>
+        BudgetGuard(const Microseconds microseconds) noexcept // NOLINT
+            : m_parent(CurrentBudget()), m_deadline(IMGUI_SUGAR_CLOCK_NS() + (microseconds > 0 ? static_cast<ImU64>(microseconds) * 1000u : 0u))
+        {
+            CurrentBudget() = this;
+        }
+
+        BudgetGuard(const BudgetGuard&) = delete;
+        BudgetGuard(BudgetGuard&&) = delete;
+        BudgetGuard& operator=(const BudgetGuard&) = delete; // NOLINT
+        BudgetGuard& operator=(BudgetGuard&&) = delete; // NOLINT
+
+        ~BudgetGuard() noexcept { CurrentBudget() = m_parent; }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+
+        private:
+            friend auto IsOverBudget() noexcept -> bool;
+
+            const BudgetGuard* const m_parent;
+            const ImU64 m_deadline;
+    };
+
+    // True when the innermost budget or any enclosing one is exceeded, false outside budgets
+    inline auto IsOverBudget() noexcept -> bool
+    {
+        const BudgetGuard* budget = CurrentBudget();
+        if (budget == nullptr) { return false; }
+        const ImU64 now = IMGUI_SUGAR_CLOCK_NS();
+        for (; budget != nullptr; budget = budget->m_parent)
+        {
+            if (now > budget->m_deadline) { return true; }
+        }
+        return false;
+    }
+
+    // Low priority child of a budget: runs (and records its draw output) while there is time left.
+    // Over budget the body is skipped and its last recording replayed, with the layout preserved.
+    // Same limitations as with_CachedRegion: items of a replayed body do not exist for that frame.
+    struct LowPriorityGuard : CachedRegionGuard
+    {
+        LowPriorityGuard(const char* key) // NOLINT
+            : CachedRegionGuard(key, IsOverBudget() ? Mode::Replay : Mode::Record) {}
+    };
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Idle frames
+// ----------------------------------------------------------------------------
+
+namespace ImGuiSugar
+{
+    inline auto HashBytes(const void* data, const size_t size, ImU64 hash) noexcept -> ImU64
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            ImU64 word;
+            memcpy(&word, bytes + i, 8);
+            hash = (hash ^ word) * 0x100000001b3ULL;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i) { hash = (hash ^ bytes[i]) * 0x100000001b3ULL; }
+        return hash;
+    }
+
+    // Hash of everything a renderer backend consumes: display, commands, vertices and indices
+    inline auto HashDrawData(const ImDrawData* drawData) noexcept -> ImU64
+    {
+        ImU64 hash = 0xcbf29ce484222325ULL;
+        if (drawData == nullptr || !drawData->Valid) { return hash; }
+        const float display[6] = {drawData->DisplayPos.x, drawData->DisplayPos.y, drawData->DisplaySize.x,
+                                  drawData->DisplaySize.y, drawData->FramebufferScale.x, drawData->FramebufferScale.y};
+        hash = HashBytes(display, sizeof(display), hash);
+        for (int n = 0; n < drawData->CmdListsCount; ++n)
+        {
+            const ImDrawList* drawList = drawData->CmdLists[n];
+            for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+            {
+                hash = HashBytes(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+                hash = HashBytes(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+                const unsigned int counts[3] = {cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount};
+                hash = HashBytes(counts, sizeof(counts), hash);
+                hash = HashBytes(&cmd.UserCallback, sizeof(cmd.UserCallback), hash);
+            }
+            hash = HashBytes(drawList->VtxBuffer.Data, sizeof(ImDrawVert) * drawList->VtxBuffer.Size, hash);
+            hash = HashBytes(drawList->IdxBuffer.Data, sizeof(ImDrawIdx) * drawList->IdxBuffer.Size, hash);
+        }
+        return hash;
+    }
+
+    // Whether a mouse button or a key (keyboard, gamepad) is held down
+    inline auto IsAnyInputDown() -> bool
+    {
+        if (ImGui::IsAnyMouseDown()) { return true; }
+#if IMGUI_VERSION_NUM >= 18700
+        for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; ++key)
+        {
+            if (ImGui::IsKeyDown(static_cast<ImGuiKey>(key))) { return true; }
+        }
+#else
+        for (const bool down : ImGui::GetIO().KeysDown)
+        {
+            if (down) { return true; }
+        }
+#endif
+        return false;
+    }
+
+    // Event driven redraw: reports if the rendered frame differs from the previous one and how long
+    // the application may sleep waiting for events before the next frame.
+    //
+    //   const double timeout = idle.GetWaitTimeout();
+    //   if (timeout < 0.0)      glfwWaitEvents();
+    //   else if (timeout > 0.0) glfwWaitEventsTimeout(timeout);
+    //   else                    glfwPollEvents();
+    //   ... NewFrame, UI, Render ...
+    //   if (idle.EndFrame()) { ... render draw data, swap buffers ... }
+    //
+    // Input wakes the event wait by itself. While a mouse button or a key is held, the wait is at
+    // most io.KeyRepeatRate so key and button repeats keep firing. Animations and background work call Invalidate()
+    // (any thread, set wakeCallback to e.g. glfwPostEmptyEvent) or InvalidateAfter(seconds).
+    struct IdleFramePolicy
+    {
+        int settleFrames = 3;            // Frames kept running after a change, hover and layout take a few to settle
+        double textInputTimeout = 0.25;  // Max wait while a text field is active (cursor blink)
+        void (*wakeCallback)(void* userData) = nullptr; // Called by Invalidate() to interrupt the event wait
+        void* wakeUserData = nullptr;
+
+        IdleFramePolicy() = default;
+        IdleFramePolicy(const IdleFramePolicy&) = delete;
+        IdleFramePolicy& operator=(const IdleFramePolicy&) = delete; // NOLINT
+
+        // Call after ImGui::Render(). Returns true if the frame differs from the previous one.
+        auto EndFrame(const ImDrawData* drawData) -> bool
+        {
+            const ImU64 hash = HashDrawData(drawData);
+            const bool changed = hash != m_hash || m_frames == 0;
+            m_hash = hash;
+            ++m_frames;
+            m_unchangedFrames = changed ? 0 : m_unchangedFrames + 1;
+            m_now = ImGui::GetTime();
+            m_textInput = ImGui::GetIO().WantTextInput;
+            m_inputHeldTimeout = IsAnyInputDown() ? static_cast<double>(ImGui::GetIO().KeyRepeatRate) : -1.0;
+            if (m_timer >= 0.0 && m_timer <= m_now) { m_timer = -1.0; }
+            return changed;
+        }
+
+        auto EndFrame() -> bool { return EndFrame(ImGui::GetDrawData()); }
+
+        auto IsIdle() const noexcept -> bool { return m_unchangedFrames >= settleFrames; }
+
+        // Seconds to wait for events before the next frame: 0 to run now, < 0 to wait without timeout
+        auto GetWaitTimeout() -> double
+        {
+            if (m_invalidated.exchange(false) || !IsIdle()) { return 0.0; }
+            double timeout = m_textInput ? textInputTimeout : -1.0;
+            if (m_inputHeldTimeout >= 0.0)
+            {
+                timeout = timeout < 0.0 || m_inputHeldTimeout < timeout ? m_inputHeldTimeout : timeout;
+            }
+            if (m_timer >= 0.0)
+            {
+                const double untilTimer = m_timer > m_now ? m_timer - m_now : 0.0;
+                timeout = timeout < 0.0 || untilTimer < timeout ? untilTimer : timeout;
+            }
+            return timeout;
+        }
+
+        // Requests a new frame, safe from any thread
+        void Invalidate()
+        {
+            m_invalidated.store(true);
+            if (wakeCallback != nullptr) { wakeCallback(wakeUserData); }
+        }
+
+        // Requests a new frame in the given seconds (UI thread), e.g. for the next animation step
+        void InvalidateAfter(const double seconds)
+        {
+            const double at = ImGui::GetTime() + seconds;
+            if (m_timer < 0.0 || at < m_timer) { m_timer = at; }
+        }
+
+        private:
+            std::atomic<bool> m_invalidated{false};
+            ImU64 m_hash = 0;
+            int m_frames = 0;
+            int m_unchangedFrames = 0;
+            double m_now = 0.0;
+            double m_timer = -1.0;
+            double m_inputHeldTimeout = -1.0; // io.KeyRepeatRate while input is held, -1 otherwise
+            bool m_textInput = false;
+    };
+
+} // namespace ImGuiSugar
+
+// ----------------------------------------------------------------------------
+// [SECTION] Asynchronous tree children (IMGUI_SUGAR_ENABLE_ASYNC)
+// ----------------------------------------------------------------------------
+//
+// Tree nodes whose children come from a slow source (file system, database...).
+// Children are requested on first expansion, loaded off the UI thread by an
+// executor and cached until invalidated. A placeholder row is shown meanwhile.
+//
+// Opt-in because it needs the standard library threading support.
+
+#ifdef IMGUI_SUGAR_ENABLE_ASYNC
+
+namespace ImGuiSugar
+{
+    // Runs tasks off the UI thread. Implement it to plug your own job system.
+    struct TaskExecutor
+    {
+        virtual ~TaskExecutor() = default;
+        virtual void Submit(std::function<void()> task) = 0;
+    };
+
+    // Plain std::thread pool. Pending tasks are dropped on destruction, running ones are joined.
+    struct ThreadPoolExecutor : TaskExecutor
+    {
+        explicit ThreadPoolExecutor(const unsigned threads = 2)
+        {
+            for (unsigned i = 0; i < (threads > 0 ? threads : 1); ++i)
+            {
+                m_threads.emplace_back([this]() { Run(); });
+            }
+        }
+
+        ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+        ThreadPoolExecutor(ThreadPoolExecutor&&) = delete;
+        ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete; // NOLINT
+        ThreadPoolExecutor& operator=(ThreadPoolExecutor&&) = delete; // NOLINT
+
+        ~ThreadPoolExecutor() override
+        {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::thread& thread : m_threads) { thread.join(); }
+        }
+
+        void Submit(std::function<void()> task) override
+        {
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_wake.notify_one();
+        }
+
+        private:
+            void Run()
+            {
+                for (;;)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                        if (m_stop) { return; }
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+
+            std::mutex m_mutex;
+            std::condition_variable m_wake;
+            std::deque<std::function<void()>> m_tasks;
+            std::vector<std::thread> m_threads;
+            bool m_stop = false;
+    };
+
+    // One loaded child: its label (also the ID, as in with_TreeNode), a user handle and a leaf hint
+    struct AsyncChild
+    {
+        std::string label;
+        ImU64 node;
+        bool leaf;
+    };
+
+    // Cache of asynchronously loaded children, keyed by node handle. Used from the UI thread only,
+    // the loader runs on the executor and must not call ImGui.
+    struct AsyncChildren
+    {
+        using Loader = std::function<std::vector<AsyncChild>(ImU64 node)>;
+
+        AsyncChildren(TaskExecutor& executor, Loader loader, const char* placeholder = "Loading...")
+            : m_executor(executor), m_loader(std::move(loader)), m_placeholder(placeholder),
+              m_results(std::make_shared<Results>()) {}
+
+        AsyncChildren(const AsyncChildren&) = delete;
+        AsyncChildren(AsyncChildren&&) = delete;
+        AsyncChildren& operator=(const AsyncChildren&) = delete; // NOLINT
+        AsyncChildren& operator=(AsyncChildren&&) = delete; // NOLINT
+
+        // Children of node, nullptr while the first load is running (it is started on the first call).
+        // Invalidated nodes keep returning the previous children until the new ones arrive.
+        auto Get(const ImU64 node) -> const std::vector<AsyncChild>*
+        {
+            Collect();
+            Entry& entry = m_entries[node];
+            if (entry.ticket == 0 || (entry.stale && !entry.pending)) { Load(node, entry); }
+            return entry.loaded ? &entry.children : nullptr;
+        }
+
+        auto IsLoading(const ImU64 node) const -> bool
+        {
+            const auto it = m_entries.find(node);
+            return it != m_entries.end() && it->second.pending;
+        }
+
+        // Reloads node children the next time they are shown
+        void Invalidate(const ImU64 node)
+        {
+            const auto it = m_entries.find(node);
+            if (it != m_entries.end()) { it->second.stale = true; }
+        }
+
+        // Forgets everything, in-flight results are discarded
+        void Clear() { m_entries.clear(); }
+
+        auto GetPlaceholder() const noexcept -> const char* { return m_placeholder; }
+
+        private:
+            struct Entry
+            {
+                std::vector<AsyncChild> children;
+                unsigned ticket = 0; // Identifies the latest request, older results are dropped
+                bool loaded = false;
+                bool pending = false;
+                bool stale = false;
+            };
+
+            struct Result
+            {
+                ImU64 node;
+                unsigned ticket;
+                std::vector<AsyncChild> children;
+            };
+
+            // Shared with the tasks, so late results never touch a destroyed cache
+            struct Results
+            {
+                std::mutex mutex;
+                std::vector<Result> done;
+            };
+
+            void Load(const ImU64 node, Entry& entry)
+            {
+                entry.ticket = ++m_lastTicket;
+                entry.pending = true;
+                entry.stale = false;
+                const unsigned ticket = entry.ticket;
+                const Loader loader = m_loader;
+                const std::shared_ptr<Results> results = m_results;
+                m_executor.Submit([node, ticket, loader, results]()
+                {
+                    Result result{node, ticket, loader(node)};
+                    const std::lock_guard<std::mutex> lock(results->mutex);
+                    results->done.push_back(std::move(result));
+                });
+            }
+
+            void Collect()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(m_results->mutex);
+                    if (m_results->done.empty()) { return; }
+                    m_collected.swap(m_results->done);
+                }
+                for (Result& result : m_collected)
+                {
+                    const auto it = m_entries.find(result.node);
+                    if (it == m_entries.end() || it->second.ticket != result.ticket) { continue; }
+                    it->second.children = std::move(result.children);
+                    it->second.loaded = true;
+                    it->second.pending = false;
+                }
+                m_collected.clear();
+            }
+
+            TaskExecutor& m_executor;
+            const Loader m_loader;
+            const char* m_placeholder;
+            std::shared_ptr<Results> m_results;
+            std::vector<Result> m_collected;
+            std::unordered_map<ImU64, Entry> m_entries;
+            unsigned m_lastTicket = 0;
+    };
+
+    // TreeNode whose body iterates the loaded children. While loading, the node shows the placeholder
+    // row instead and the body is skipped.
+    struct AsyncTreeNodeGuard
+    {
+        AsyncTreeNodeGuard(AsyncChildren& cache, const ImU64 node, const char* label, const ImGuiTreeNodeFlags flags = 0)
+            : m_open(ImGui::TreeNodeEx(label, flags))
+        {
+            if (!m_open) { return; }
+            m_children = cache.Get(node);
+            if (m_children == nullptr) { ImGui::TextDisabled("%s", cache.GetPlaceholder()); }
+        }
+
+        AsyncTreeNodeGuard(const AsyncTreeNodeGuard&) = delete;
+        AsyncTreeNodeGuard(AsyncTreeNodeGuard&&) = delete;
+        AsyncTreeNodeGuard& operator=(const AsyncTreeNodeGuard&) = delete; // NOLINT
+        AsyncTreeNodeGuard& operator=(AsyncTreeNodeGuard&&) = delete; // NOLINT
+
+        ~AsyncTreeNodeGuard() noexcept
+        {
+            if (m_open) { ImGui::TreePop(); }
+        }
+
+        operator bool() const & noexcept { return m_children != nullptr; } // (Implicit) NOLINT
+
+        auto Children() const noexcept -> const std::vector<AsyncChild>& { return *m_children; }
+
+        private:
+            const bool m_open;
+            const std::vector<AsyncChild>* m_children = nullptr;
+    };
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_ENABLE_ASYNC
+
+// ----------------------------------------------------------------------------
+// [SECTION] Scope instrumentation (opt-in)
+// ----------------------------------------------------------------------------
+//
+// Defining IMGUI_SUGAR_PROFILE (trace events), IMGUI_SUGAR_STATS (per site
+// percentiles), IMGUI_SUGAR_DRAW_STATS (per site draw list growth) or
+// IMGUI_SUGAR_ALLOC_STATS (per site ImGui allocations) before including this
+// header makes every with_*/set_* scope built on BooleanGuard/VoidGuard
+// report its entry and exit.
+// Without them, the guards and macros are exactly the plain ones above.
+// IMGUI_SUGAR_INSTRUMENT is derived from them at the top of this header.
+
+#ifdef IMGUI_SUGAR_INSTRUMENT
+
+// Scope timings use IMGUI_SUGAR_CLOCK_NS, see Frame time budgets
+
+// Deeper scopes are still balanced but not recorded
+#ifndef IMGUI_SUGAR_MAX_SCOPE_DEPTH
+#define IMGUI_SUGAR_MAX_SCOPE_DEPTH 256
+#endif
+
+// Distinct instrumented sites tracked, power of two; later sites share one entry
+#ifndef IMGUI_SUGAR_MAX_SCOPE_SITES
+#define IMGUI_SUGAR_MAX_SCOPE_SITES 4096
+#endif
+
+// Number of events kept per thread by the profiler ring buffer
+#ifndef IMGUI_SUGAR_PROFILE_CAPACITY
+#define IMGUI_SUGAR_PROFILE_CAPACITY 65536
+#endif
+
+namespace ImGuiSugar
+{
+    struct ScopeSite;
+
+#ifdef IMGUI_SUGAR_STATS
+
+    // Frame-over-frame timing of one scope site: per frame total time recorded
+    // into a log-linear histogram (4 sub-buckets per power of two, ~25% precision).
+    struct ScopeStats
+    {
+        enum { SubBits = 2, Sub = 1 << SubBits, BucketCount = 40 * Sub };
+
+        ImU64 frameTotal;  // Time spent in the current frame (ns)
+        ImU32 frameCalls;  // Scopes entered in the current frame
+        int touchedFrame;  // 1 + last sampled frame this site was entered in (0 = never)
+        ImU64 samples;     // Number of recorded frames
+        ImU64 max;         // Exact maximum frame total (ns)
+        ImU32 buckets[BucketCount];
+
+        static auto BucketIndex(const ImU64 ns) -> int
+        {
+            if (ns < Sub) { return static_cast<int>(ns); }
+            int msb = 0;
+            for (ImU64 v = ns; v > 1; v >>= 1) { ++msb; }
+            const int idx = (msb - SubBits + 1) * Sub + static_cast<int>((ns >> (msb - SubBits)) & (Sub - 1));
+            return idx < BucketCount ? idx : BucketCount - 1;
+        }
+
+        static auto BucketUpperBound(const int idx) -> ImU64
+        {
+            if (idx < Sub) { return static_cast<ImU64>(idx); }
+            const int shift = idx / Sub - 1;
+            return ((static_cast<ImU64>(Sub + idx % Sub) + 1) << shift) - 1;
+        }
+    };
+
+#endif // IMGUI_SUGAR_STATS
+
+#ifdef IMGUI_SUGAR_DRAW_STATS
+
+    // Draw list growth (vertices, indices, draw commands) between the Begin*/Push*
+    // and End*/Pop* calls of one scope site, summed per frame. Inclusive of nested
+    // scopes drawing into the same draw list (child windows have their own).
+    struct ScopeDrawStats
+    {
+        struct Counts
+        {
+            ImU32 calls;
+            ImU32 vtx;
+            ImU32 idx;
+            ImU32 cmd;
+        };
+
+        int frame;   // ImGui frame of current
+        Counts current;
+        Counts last; // Frame before current
+        Counts max;  // Worst frame seen
+    };
+
+#endif // IMGUI_SUGAR_DRAW_STATS
+
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+
+    // ImGui heap allocations made while a scope site was the innermost active scope
+    struct ScopeAllocStats
+    {
+        struct Counts
+        {
+            ImU32 allocs;
+            ImU64 bytes;
+        };
+
+        int frame;    // ImGui frame of current
+        Counts current;
+        Counts last;  // Frame before current
+        Counts total; // Since first use
+    };
+
+#endif // IMGUI_SUGAR_ALLOC_STATS
+
+    // Description of a scope use site, one per with_*/set_* expansion, interned
+    // on its first entry (see InternScopeSite and IMGUI_SUGAR_PROBE). Interning is lock-free from any thread;
+    // the statistics below are updated without synchronization, instrument the
+    // scopes of the thread driving the ImGui context only.
+    struct ScopeSite
+    {
+        ScopeSite(const char* beginName, const char* fileName, const int lineNumber) noexcept
+            : name(beginName), file(fileName), line(lineNumber), next(nullptr)
+#ifdef IMGUI_SUGAR_STATS
+            , stats()
+#endif
+#ifdef IMGUI_SUGAR_DRAW_STATS
+            , draw()
+#endif
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+            , alloc()
+#endif
+        {}
+
+        const char* name; // Begin*/Push* function
+        const char* file;
+        int line;
+
+        const ScopeSite* next; // Registered sites list, see GetFirstScopeSite
+
+#ifdef IMGUI_SUGAR_STATS
+        mutable ScopeStats stats;
+#endif
+#ifdef IMGUI_SUGAR_DRAW_STATS
+        mutable ScopeDrawStats draw;
+#endif
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+        mutable ScopeAllocStats alloc;
+#endif
+    };
+
+    // All sites entered at least once, hashed by the addresses of their name and
+    // file literals and their line, and listed in reverse order of first use.
+    // Zero initialized as a static, sites are never freed.
+    struct ScopeSiteRegistry
+    {
+        std::atomic<const ScopeSite*> slots[IMGUI_SUGAR_MAX_SCOPE_SITES];
+        std::atomic<const ScopeSite*> first;
+    };
+
+    inline auto GetScopeSiteRegistry() -> ScopeSiteRegistry&
+    {
+        static ScopeSiteRegistry registry;
+        return registry;
+    }
 
-namespace ImGuiSugar
-{
-    using ScopeEndCallback = void(*)();
+    // First registered site, follow site->next for the rest
+    inline auto GetFirstScopeSite() -> const ScopeSite*
+    {
+        return GetScopeSiteRegistry().first.load(std::memory_order_acquire);
+    }
 
-    // RAII scope guard for ImGui Begin* functions returning bool.
-    template<bool AlwaysCallEnd>
-    struct BooleanGuard
+    // Site of a with_*/set_* expansion, created on its first entry. Literals are
+    // compared by address: a site in a header used by several translation units
+    // may be listed once per unit.
+    inline auto InternScopeSite(const char* name, const char* file, const int line) -> const ScopeSite&
     {
-        BooleanGuard(const bool state, const ScopeEndCallback end) noexcept
-            : m_state(state), m_end(end) {}
+        static_assert((IMGUI_SUGAR_MAX_SCOPE_SITES & (IMGUI_SUGAR_MAX_SCOPE_SITES - 1)) == 0, "IMGUI_SUGAR_MAX_SCOPE_SITES must be a power of two");
 
-        BooleanGuard(const BooleanGuard<AlwaysCallEnd>&) = delete;
-        BooleanGuard(BooleanGuard<AlwaysCallEnd>&&) = delete;
-        BooleanGuard<AlwaysCallEnd>& operator=(const BooleanGuard<AlwaysCallEnd>&) = delete; // NOLINT
-        BooleanGuard<AlwaysCallEnd>& operator=(BooleanGuard<AlwaysCallEnd>&&) = delete; // NOLINT
+        ImU64 hash = reinterpret_cast<size_t>(file) * 0x9E3779B97F4A7C15ull;
+        hash ^= reinterpret_cast<size_t>(name) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= static_cast<ImU64>(line) * 0x165667B19E3779F9ull;
+        hash ^= hash >> 32;
 
-        ~BooleanGuard() noexcept;
+        ScopeSiteRegistry& registry = GetScopeSiteRegistry();
+        ScopeSite* created = nullptr;
+        for (size_t probe = 0; probe < IMGUI_SUGAR_MAX_SCOPE_SITES; ++probe)
+        {
+            std::atomic<const ScopeSite*>& slot = registry.slots[(hash + probe) & (IMGUI_SUGAR_MAX_SCOPE_SITES - 1)];
+            const ScopeSite* site = slot.load(std::memory_order_acquire);
+            if (site == nullptr)
+            {
+                if (created == nullptr) { created = new ScopeSite(name, file, line); }
+                if (slot.compare_exchange_strong(site, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    // Slot won, CAS push on the sites list
+                    const ScopeSite* head = registry.first.load(std::memory_order_relaxed);
+                    do { created->next = head; } while (!registry.first.compare_exchange_weak(head, created, std::memory_order_release, std::memory_order_relaxed));
+                    return *created;
+                }
+                // Another thread filled the slot first, site is its entry
+            }
+            if (site->name == name && site->file == file && site->line == line)
+            {
+                delete created;
+                return *site;
+            }
+        }
 
-        operator bool() const & noexcept { return m_state; } // (Implicit) NOLINT
+        delete created;
+        IM_ASSERT(false && "More instrumented scope sites than IMGUI_SUGAR_MAX_SCOPE_SITES");
+        static ScopeSite overflow("(overflow)", "", 0);
+        return overflow;
+    }
 
-        private:
-            const bool m_state;
-            const ScopeEndCallback m_end;
+    // Per thread stack of active scopes
+    struct ScopeStack
+    {
+        struct Entry
+        {
+            const ScopeSite* site;
+            ImU64 begin;
+#ifdef IMGUI_SUGAR_DRAW_STATS
+            const ImDrawList* drawList;
+            int vtx;
+            int idx;
+            int cmd;
+#endif
+        };
+
+        Entry entries[IMGUI_SUGAR_MAX_SCOPE_DEPTH];
+        int depth = 0;
+    };
+
+    inline auto GetScopeStack() -> ScopeStack&
+    {
+        static thread_local ScopeStack stack;
+        return stack;
+    }
+
+#ifdef IMGUI_SUGAR_PROFILE
+
+    struct ProfileEvent
+    {
+        const ScopeSite* site;
+        ImU64 begin;
+        ImU64 end;
+        int depth;
+    };
+
+    // Per thread ring buffer of completed scopes. Only the owner thread writes
+    // and reads it, so no locking is involved.
+    struct ProfileBuffer
+    {
+        ProfileBuffer() : events(new ProfileEvent[IMGUI_SUGAR_PROFILE_CAPACITY]), threadId(NextThreadId()) {}
+        ~ProfileBuffer() { delete[] events; }
+
+        ProfileBuffer(const ProfileBuffer&) = delete;
+        ProfileBuffer& operator=(const ProfileBuffer&) = delete; // NOLINT
+
+        ProfileEvent* events;
+        ImU64 written = 0;    // Total events ever written
+        ImU64 frameStart = 0; // Value of written at the last ProfileNewFrame()
+        const int threadId;
+
+        static auto NextThreadId() -> int
+        {
+            static std::atomic<int> next(0);
+            return next++;
+        }
     };
 
-    template<>
-    inline BooleanGuard<true>::~BooleanGuard() noexcept { m_end(); }
+    inline auto GetProfileBuffer() -> ProfileBuffer&
+    {
+        static thread_local ProfileBuffer buffer;
+        return buffer;
+    }
 
-    template<>
-    inline BooleanGuard<false>::~BooleanGuard() noexcept 
-    { 
-        if (m_state) { m_end(); } 
+    // Marks the start of a new frame on the calling thread (call right after ImGui::NewFrame)
+    inline void ProfileNewFrame()
+    {
+        ProfileBuffer& buffer = GetProfileBuffer();
+        buffer.frameStart = buffer.written;
     }
 
-    // For special cases, transform void(*)(int) to void(*)()
-    inline void PopStyleColor() { ImGui::PopStyleColor(1); };
-    inline void PopStyleVar()   { ImGui::PopStyleVar(1); };
-    inline void Unindent()      { ImGui::Unindent(); }
+    inline void AppendJsonString(ImGuiTextBuffer& out, const char* str)
+    {
+        out.append("\"");
+        for (const char* p = str; *p; ++p)
+        {
+            if (*p == '"' || *p == '\\') { out.appendf("\\%c", *p); }
+            else if ((unsigned char)*p < 0x20) { out.appendf("\\u%04x", *p); }
+            else { out.append(p, p + 1); }
+        }
+        out.append("\"");
+    }
 
-    // Tooltip auto triggered on hover
-    inline auto BeginTooltip() -> bool
+    // Appends the calling thread's events since ProfileNewFrame() as Chrome/Perfetto trace JSON
+    inline void WriteChromeTrace(ImGuiTextBuffer& out)
     {
-        if (ImGui::IsItemHovered())
+        const ProfileBuffer& buffer = GetProfileBuffer();
+        ImU64 first = buffer.frameStart;
+        if (buffer.written - first > IMGUI_SUGAR_PROFILE_CAPACITY)
         {
-            ImGui::BeginTooltip();
-            return true;
+            first = buffer.written - IMGUI_SUGAR_PROFILE_CAPACITY; // Oldest events were overwritten
+        }
+
+        out.append("{\"traceEvents\":[");
+        for (ImU64 i = first; i < buffer.written; ++i)
+        {
+            const ProfileEvent& e = buffer.events[i % IMGUI_SUGAR_PROFILE_CAPACITY];
+            out.append(i == first ? "\n{\"name\":" : ",\n{\"name\":");
+            AppendJsonString(out, e.site->name);
+            out.appendf(",\"cat\":\"imgui\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"file\":",
+                        e.begin / 1000.0, (e.end - e.begin) / 1000.0, buffer.threadId);
+            AppendJsonString(out, e.site->file);
+            out.appendf(",\"line\":%d,\"depth\":%d}}", e.site->line, e.depth);
+        }
+        out.append("\n],\"displayTimeUnit\":\"ns\"}\n");
+    }
+
+#endif // IMGUI_SUGAR_PROFILE
+
+#ifdef IMGUI_SUGAR_STATS
+
+    struct ScopeTimings
+    {
+        ImU64 samples; // Recorded frames
+        ImU64 p50;     // Per frame time in nanoseconds (bucket upper bound)
+        ImU64 p95;
+        ImU64 p99;
+        ImU64 max;     // Exact
+    };
+
+    // Global statistics state, owned by the UI thread
+    struct ScopeStatsContext
+    {
+        ImVector<const ScopeSite*> touched; // Sites entered in the current sampled frame
+        int frame = 0;
+        int sampleEvery = 1;
+        bool sampling = true;
+    };
+
+    inline auto GetScopeStatsContext() -> ScopeStatsContext&
+    {
+        static ScopeStatsContext ctx;
+        return ctx;
+    }
+
+    // Records 1 of every N frames (N = 1 records all frames)
+    inline void SetScopeStatsSampling(const int everyNFrames)
+    {
+        GetScopeStatsContext().sampleEvery = everyNFrames > 0 ? everyNFrames : 1;
+    }
+
+    // Commits the previous frame into the histograms (call right after ImGui::NewFrame)
+    inline void ScopeStatsNewFrame()
+    {
+        ScopeStatsContext& ctx = GetScopeStatsContext();
+        for (const ScopeSite* site : ctx.touched)
+        {
+            ScopeStats& stats = site->stats;
+            ++stats.buckets[ScopeStats::BucketIndex(stats.frameTotal)];
+            ++stats.samples;
+            if (stats.frameTotal > stats.max) { stats.max = stats.frameTotal; }
+            stats.frameTotal = 0;
+            stats.frameCalls = 0;
+        }
+        ctx.touched.resize(0);
+        ++ctx.frame;
+        ctx.sampling = (ctx.frame % ctx.sampleEvery) == 0;
+    }
+
+    inline auto GetScopeTimings(const ScopeSite& site) -> ScopeTimings
+    {
+        const ScopeStats& stats = site.stats;
+        ScopeTimings timings = { stats.samples, 0, 0, 0, stats.max };
+        const ImU64 targets[3] = { (stats.samples * 50 + 99) / 100, (stats.samples * 95 + 99) / 100, (stats.samples * 99 + 99) / 100 };
+        ImU64* results[3] = { &timings.p50, &timings.p95, &timings.p99 };
+        ImU64 accum = 0;
+        int q = 0;
+        for (int i = 0; i < ScopeStats::BucketCount && q < 3; ++i)
+        {
+            accum += stats.buckets[i];
+            while (q < 3 && accum >= targets[q] && accum > 0)
+            {
+                const ImU64 bound = ScopeStats::BucketUpperBound(i);
+                *results[q++] = bound < stats.max ? bound : stats.max;
+            }
+        }
+        return timings;
+    }
+
+    inline void ResetScopeStats()
+    {
+        for (const ScopeSite* site = GetFirstScopeSite(); site; site = site->next)
+        {
+            site->stats = ScopeStats();
+        }
+        GetScopeStatsContext().touched.resize(0);
+    }
+
+    inline void RecordScopeTime(const ScopeSite& site, const ImU64 ns)
+    {
+        ScopeStatsContext& ctx = GetScopeStatsContext();
+        ScopeStats& stats = site.stats;
+        if (stats.touchedFrame != ctx.frame + 1)
+        {
+            stats.touchedFrame = ctx.frame + 1;
+            ctx.touched.push_back(&site);
+        }
+        stats.frameTotal += ns;
+        ++stats.frameCalls;
+    }
+
+#endif // IMGUI_SUGAR_STATS
+
+#ifdef IMGUI_SUGAR_DRAW_STATS
+
+    // Draw cost of a site in the last completed frame and in its worst frame
+    inline auto GetScopeDrawCost(const ScopeSite& site, ScopeDrawStats::Counts* worst = nullptr) -> ScopeDrawStats::Counts
+    {
+        const ScopeDrawStats& draw = site.draw;
+        const ScopeDrawStats::Counts none = { 0, 0, 0, 0 };
+        if (worst) { *worst = draw.max; }
+        const int frame = ImGui::GetFrameCount();
+        if (draw.frame == frame - 1) { return draw.current; }
+        if (draw.frame == frame)     { return draw.last; }
+        return none;
+    }
+
+    inline void RecordScopeDraw(const ScopeSite& site, const ImU32 vtx, const ImU32 idx, const ImU32 cmd)
+    {
+        ScopeDrawStats& draw = site.draw;
+        const int frame = ImGui::GetFrameCount();
+        if (draw.frame != frame)
+        {
+            const ScopeDrawStats::Counts none = { 0, 0, 0, 0 };
+            draw.last = (draw.frame == frame - 1) ? draw.current : none;
+            draw.current = none;
+            draw.frame = frame;
+        }
+
+        ScopeDrawStats::Counts& c = draw.current;
+        ++c.calls;
+        c.vtx += vtx;
+        c.idx += idx;
+        c.cmd += cmd;
+
+        ScopeDrawStats::Counts& m = draw.max;
+        if (c.calls > m.calls) { m.calls = c.calls; }
+        if (c.vtx > m.vtx)     { m.vtx = c.vtx; }
+        if (c.idx > m.idx)     { m.idx = c.idx; }
+        if (c.cmd > m.cmd)     { m.cmd = c.cmd; }
+    }
+
+#endif // IMGUI_SUGAR_DRAW_STATS
+
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+
+    // Global counters of the tracking allocator
+    struct AllocationTracker
+    {
+        std::atomic<ImU64> allocs{0};    // Since install
+        std::atomic<ImU64> frees{0};
+        std::atomic<ImU64> liveBytes{0};
+        std::atomic<ImU64> peakBytes{0};
+        std::atomic<ImU64> limitViolations{0}; // Failed with_AllocationLimit/with_NoAllocations scopes
+
+        // Per frame totals, updated from any allocating thread. The thread that moves
+        // frame forward rolls current into last; allocations racing with the roll
+        // over may be counted in either frame.
+        std::atomic<int> frame{-1};
+        std::atomic<ImU32> currentAllocs{0};
+        std::atomic<ImU64> currentBytes{0};
+        std::atomic<ImU32> lastAllocs{0};
+        std::atomic<ImU64> lastBytes{0};
+    };
+
+    inline auto GetAllocationTracker() -> AllocationTracker&
+    {
+        static AllocationTracker tracker;
+        return tracker;
+    }
+
+    // Allocations of the last completed frame, all scopes included
+    inline auto GetFrameAllocations() -> ScopeAllocStats::Counts
+    {
+        const AllocationTracker& tracker = GetAllocationTracker();
+        const ScopeAllocStats::Counts none = { 0, 0 };
+        const int frame = ImGui::GetFrameCount();
+        const int tracked = tracker.frame.load();
+        if (tracked == frame - 1) { const ScopeAllocStats::Counts current = { tracker.currentAllocs.load(), tracker.currentBytes.load() }; return current; }
+        if (tracked == frame)     { const ScopeAllocStats::Counts last = { tracker.lastAllocs.load(), tracker.lastBytes.load() }; return last; }
+        return none;
+    }
+
+    // Allocations attributed to a site in the last completed frame (and since first use)
+    inline auto GetScopeAllocations(const ScopeSite& site, ScopeAllocStats::Counts* total = nullptr) -> ScopeAllocStats::Counts
+    {
+        const ScopeAllocStats& alloc = site.alloc;
+        const ScopeAllocStats::Counts none = { 0, 0 };
+        if (total) { *total = alloc.total; }
+        const int frame = ImGui::GetFrameCount();
+        if (alloc.frame == frame - 1) { return alloc.current; }
+        if (alloc.frame == frame)     { return alloc.last; }
+        return none;
+    }
+
+    // Allocations made by the calling thread since install
+    inline auto GetThreadAllocationCount() -> ImU64&
+    {
+        static thread_local ImU64 count = 0;
+        return count;
+    }
+
+    inline void RecordAllocation(const size_t size)
+    {
+        AllocationTracker& tracker = GetAllocationTracker();
+        ++tracker.allocs;
+        ++GetThreadAllocationCount();
+        const ImU64 live = tracker.liveBytes += size;
+        ImU64 peak = tracker.peakBytes.load();
+        while (live > peak && !tracker.peakBytes.compare_exchange_weak(peak, live)) {}
+
+        // The context may not exist yet (or anymore) while it is being created (or destroyed)
+        if (ImGui::GetCurrentContext() == nullptr) { return; }
+        const int frame = ImGui::GetFrameCount();
+        const ScopeAllocStats::Counts none = { 0, 0 };
+
+        int tracked = tracker.frame.load();
+        if (tracked != frame && tracker.frame.compare_exchange_strong(tracked, frame))
+        {
+            const ImU32 allocs = tracker.currentAllocs.exchange(0);
+            const ImU64 bytes = tracker.currentBytes.exchange(0);
+            tracker.lastAllocs = (tracked == frame - 1) ? allocs : 0;
+            tracker.lastBytes = (tracked == frame - 1) ? bytes : 0;
+        }
+        ++tracker.currentAllocs;
+        tracker.currentBytes += size;
+
+        // Attribute to the innermost active scope of this thread
+        const ScopeStack& stack = GetScopeStack();
+        if (stack.depth == 0) { return; }
+        const int top = (stack.depth < IMGUI_SUGAR_MAX_SCOPE_DEPTH ? stack.depth : IMGUI_SUGAR_MAX_SCOPE_DEPTH) - 1;
+        ScopeAllocStats& alloc = stack.entries[top].site->alloc;
+        if (alloc.frame != frame)
+        {
+            alloc.last = (alloc.frame == frame - 1) ? alloc.current : none;
+            alloc.current = none;
+            alloc.frame = frame;
+        }
+        ++alloc.current.allocs;
+        alloc.current.bytes += size;
+        ++alloc.total.allocs;
+        alloc.total.bytes += size;
+    }
+
+    // Size prefix keeping the default max alignment of malloc
+    enum { AllocationHeader = 16 };
+
+    inline auto TrackingAlloc(const size_t size, void*) -> void*
+    {
+        char* block = static_cast<char*>(malloc(size + AllocationHeader));
+        if (block == nullptr) { return nullptr; }
+        *reinterpret_cast<size_t*>(block) = size;
+        RecordAllocation(size);
+        return block + AllocationHeader;
+    }
+
+    inline void TrackingFree(void* ptr, void*)
+    {
+        if (ptr == nullptr) { return; }
+        char* block = static_cast<char*>(ptr) - AllocationHeader;
+        AllocationTracker& tracker = GetAllocationTracker();
+        ++tracker.frees;
+        tracker.liveBytes -= *reinterpret_cast<size_t*>(block);
+        free(block);
+    }
+
+    // RAII scope checking that its body made at most `limit` ImGui allocations
+    // on the calling thread (negative = no limit). Failures assert and are counted
+    // in AllocationTracker::limitViolations, so a test can check them with asserts disabled.
+    // Only allocations made through ImGui::MemAlloc are seen: new, malloc and the
+    // containers of the application or of other libraries are not checked.
+    struct AllocationLimitGuard
+    {
+        // Any integer type, so with_AllocationLimit(v.size()) is not a narrowing error
+        template<typename Count, typename std::enable_if<std::is_integral<Count>::value, int>::type = 0>
+        AllocationLimitGuard(const Count limit) noexcept // (Implicit) NOLINT
+            : m_start(GetThreadAllocationCount()), m_limit(static_cast<ImS64>(limit)) {}
+
+        AllocationLimitGuard(const AllocationLimitGuard&) = delete;
+        AllocationLimitGuard(AllocationLimitGuard&&) = delete;
+        AllocationLimitGuard& operator=(const AllocationLimitGuard&) = delete; // NOLINT
+        AllocationLimitGuard& operator=(AllocationLimitGuard&&) = delete; // NOLINT
+
+        ~AllocationLimitGuard() noexcept
+        {
+            if (m_limit >= 0 && GetThreadAllocationCount() - m_start > static_cast<ImU64>(m_limit))
+            {
+                ++GetAllocationTracker().limitViolations;
+                IM_ASSERT(false && "ImGui allocation limit exceeded in with_AllocationLimit/with_NoAllocations scope");
+            }
         }
+
+        operator bool() const & noexcept { return true; } // (Implicit) NOLINT
+
+        private:
+            const ImU64 m_start;
+            const ImS64 m_limit;
+    };
+
+    // Routes ImGui allocations through the tracker. Like ImGui::SetAllocatorFunctions,
+    // call it before ImGui::CreateContext (memory must be freed by the allocator that made it).
+    inline void InstallAllocationTracker()
+    {
+        ImGui::SetAllocatorFunctions(&TrackingAlloc, &TrackingFree, nullptr);
+    }
+
+#endif // IMGUI_SUGAR_ALLOC_STATS
+
+    // Whether scope entry/exit timestamps are needed right now: the profiler records
+    // every frame, the statistics only the sampled ones
+    inline auto ScopeTimingActive() -> bool
+    {
+#if defined(IMGUI_SUGAR_PROFILE)
+        return true;
+#elif defined(IMGUI_SUGAR_STATS)
+        return GetScopeStatsContext().sampling;
+#else
         return false;
+#endif
+    }
+
+    // Called before the Begin*/Push* function of an instrumented scope
+    inline auto ScopeEnter(const ScopeSite& site) noexcept -> const ScopeSite&
+    {
+        ScopeStack& stack = GetScopeStack();
+        if (stack.depth < IMGUI_SUGAR_MAX_SCOPE_DEPTH)
+        {
+            ScopeStack::Entry& entry = stack.entries[stack.depth];
+            entry.site = &site;
+            entry.begin = ScopeTimingActive() ? IMGUI_SUGAR_CLOCK_NS() : 0;
+        }
+        ++stack.depth;
+        return site;
+    }
+
+    // Called after the End*/Pop* function of an instrumented scope
+    inline void ScopeExit(const ScopeSite& site) noexcept
+    {
+        ScopeStack& stack = GetScopeStack();
+        if (--stack.depth >= IMGUI_SUGAR_MAX_SCOPE_DEPTH) { return; }
+
+        const ScopeStack::Entry& entry = stack.entries[stack.depth];
+        IM_ASSERT(entry.site == &site);
+
+        if (entry.begin != 0)
+        {
+            const ImU64 end = IMGUI_SUGAR_CLOCK_NS();
+#ifdef IMGUI_SUGAR_PROFILE
+            ProfileBuffer& buffer = GetProfileBuffer();
+            ProfileEvent& e = buffer.events[buffer.written++ % IMGUI_SUGAR_PROFILE_CAPACITY];
+            e.site = &site;
+            e.begin = entry.begin;
+            e.end = end;
+            e.depth = stack.depth;
+#endif
+#ifdef IMGUI_SUGAR_STATS
+            if (GetScopeStatsContext().sampling) { RecordScopeTime(site, end - entry.begin); }
+#endif
+            (void)end;
+        }
+        (void)site;
+    }
+
+    // Called right after the Begin*/Push* function of an instrumented scope
+    inline void ScopeBegun() noexcept
+    {
+#ifdef IMGUI_SUGAR_DRAW_STATS
+        ScopeStack& stack = GetScopeStack();
+        if (stack.depth > IMGUI_SUGAR_MAX_SCOPE_DEPTH) { return; }
+
+        ScopeStack::Entry& entry = stack.entries[stack.depth - 1];
+        const ImDrawList* drawList = ImGui::GetWindowDrawList();
+        entry.drawList = drawList;
+        entry.vtx = drawList->VtxBuffer.Size;
+        entry.idx = drawList->IdxBuffer.Size;
+        entry.cmd = drawList->CmdBuffer.Size;
+#endif
+    }
+
+    // Called right before the End*/Pop* function of an instrumented scope
+    inline void ScopeEnding() noexcept
+    {
+#ifdef IMGUI_SUGAR_DRAW_STATS
+        ScopeStack& stack = GetScopeStack();
+        if (stack.depth > IMGUI_SUGAR_MAX_SCOPE_DEPTH) { return; }
+
+        const ScopeStack::Entry& entry = stack.entries[stack.depth - 1];
+        const ImDrawList* drawList = ImGui::GetWindowDrawList();
+        if (drawList != entry.drawList) { return; }
+
+        const int vtx = drawList->VtxBuffer.Size - entry.vtx;
+        const int idx = drawList->IdxBuffer.Size - entry.idx;
+        const int cmd = drawList->CmdBuffer.Size - entry.cmd;
+        RecordScopeDraw(*entry.site, vtx > 0 ? vtx : 0, idx > 0 ? idx : 0, cmd > 0 ? cmd : 0);
+#endif
     }
 
+    // Calls ScopeExit after the wrapped guard called End*/Pop*
+    struct ScopeProbe
+    {
+        explicit ScopeProbe(const ScopeSite& site) noexcept : m_site(site) {}
+        ~ScopeProbe() noexcept { ScopeExit(m_site); }
+
+        ScopeProbe(const ScopeProbe&) = delete;
+        ScopeProbe& operator=(const ScopeProbe&) = delete; // NOLINT
+
+        private:
+            const ScopeSite& m_site;
+    };
+
+    // Instrumented version of a guard, bases are destroyed in reverse order: Guard, then ScopeProbe.
+    template<typename Guard>
+    struct ProbedGuard : ScopeProbe, Guard
+    {
+        ProbedGuard(const ScopeSite& site, const bool state) noexcept // NOLINT
+            : ScopeProbe(site), Guard(state) { ScopeBegun(); }
+
+        ~ProbedGuard() noexcept { ScopeEnding(); }
+    };
+
 } // namespace ImGuiSugar
 
+#endif // IMGUI_SUGAR_INSTRUMENT
+
 // ----------------------------------------------------------------------------
 // [SECTION] Utility macros
 // ----------------------------------------------------------------------------
 
-// Portable Expression Statement, calls void function and returns true
-#define IMGUI_SUGAR_ES(FN, ...) ([&]() -> bool { FN(__VA_ARGS__); return true; }())
-#define IMGUI_SUGAR_ES_0(FN) ([&]() -> bool { FN(); return true; }())
+// Portable Expression Statement, calls void function and returns true.
+// Comma expression instead of a lambda: no closure type per use site.
+#define IMGUI_SUGAR_ES(FN, ...) (FN(__VA_ARGS__), true)
+#define IMGUI_SUGAR_ES_0(FN) (FN(), true)
 
 // Concatenating symbols with __LINE__ requires two levels of indirection
 #define IMGUI_SUGAR_CONCAT0(A, B) A ## B
 #define IMGUI_SUGAR_CONCAT1(A, B) IMGUI_SUGAR_CONCAT0(A, B)
 
+// ID of a string literal hashed at compile time, equal to ImGui::GetID(LITERAL)
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+#define IMGUI_SUGAR_STATIC_ID(LITERAL) \
+    ImGuiSugar::StaticID<ImGuiSugar::StaticIDConstant(LITERAL), ImGuiSugar::StaticIDLength(LITERAL)>()
+#endif
+
+// Guard type and leading initializer of instrumented scopes (see IMGUI_SUGAR_INSTRUMENT).
+// Braced initializers are evaluated left to right, so ScopeEnter runs before BEGIN.
+// The site is interned once, into a function-local static of a lambda: a C++11 if
+// condition cannot declare one, and a declaration ahead of the if would break chained
+// scopes on one line. Instrumented builds only, plain scopes stay free of closures.
+#ifdef IMGUI_SUGAR_INSTRUMENT
+#define IMGUI_SUGAR_GUARD(...) ImGuiSugar::ProbedGuard<__VA_ARGS__>
+#define IMGUI_SUGAR_PROBE(BEGIN) ImGuiSugar::ScopeEnter([]() -> const ImGuiSugar::ScopeSite& { \
+        static const ImGuiSugar::ScopeSite& _ui_scope_site = ImGuiSugar::InternScopeSite(#BEGIN, __FILE__, __LINE__); \
+        return _ui_scope_site; }()),
+#else
+#define IMGUI_SUGAR_GUARD(...) __VA_ARGS__
+#define IMGUI_SUGAR_PROBE(BEGIN)
+#endif
+
 // ----------------------------------------------------------------------------
 // [SECTION] Generic macros to simplify repetitive declarations
 // ----------------------------------------------------------------------------
@@ -104,19 +3391,35 @@ namespace ImGuiSugar
 // +----------------------+-------------------+-----------------+---------------------+
 
 #define IMGUI_SUGAR_SCOPED_BOOL(BEGIN, END, ALWAYS, ...) \
-    if (const ImGuiSugar::BooleanGuard<ALWAYS> IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {BEGIN(__VA_ARGS__), &END})
+    if (const IMGUI_SUGAR_GUARD(ImGuiSugar::BooleanGuard<ALWAYS, &END>) IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_PROBE(BEGIN) BEGIN(__VA_ARGS__)})
 
 #define IMGUI_SUGAR_SCOPED_BOOL_0(BEGIN, END, ALWAYS) \
-    if (const ImGuiSugar::BooleanGuard<ALWAYS> IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {BEGIN(), &END})
+    if (const IMGUI_SUGAR_GUARD(ImGuiSugar::BooleanGuard<ALWAYS, &END>) IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_PROBE(BEGIN) BEGIN()})
 
 #define IMGUI_SUGAR_SCOPED_VOID_N(BEGIN, END, ...) \
-    if (const ImGuiSugar::BooleanGuard<true> IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_ES(BEGIN, __VA_ARGS__), &END})
+    if (const IMGUI_SUGAR_GUARD(ImGuiSugar::VoidGuard<&END>) IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_PROBE(BEGIN) IMGUI_SUGAR_ES(BEGIN, __VA_ARGS__)})
 
 #define IMGUI_SUGAR_SCOPED_VOID_0(BEGIN, END) \
-    if (const ImGuiSugar::BooleanGuard<true> IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_ES_0(BEGIN), &END})
+    if (const IMGUI_SUGAR_GUARD(ImGuiSugar::VoidGuard<&END>) IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {IMGUI_SUGAR_PROBE(BEGIN) IMGUI_SUGAR_ES_0(BEGIN)})
 
 #define IMGUI_SUGAR_PARENT_SCOPED_VOID_N(BEGIN, END, ...) \
-    const ImGuiSugar::BooleanGuard<true> IMGUI_SUGAR_CONCAT1(_ui_scope_, __LINE__) = {IMGUI_SUGAR_ES(BEGIN, __VA_ARGS__), &END}
+    const IMGUI_SUGAR_GUARD(ImGuiSugar::VoidGuard<&END>) IMGUI_SUGAR_CONCAT1(_ui_scope_, __LINE__) = {IMGUI_SUGAR_PROBE(BEGIN) IMGUI_SUGAR_ES(BEGIN, __VA_ARGS__)}
+
+// Guards constructed directly from __VA_ARGS__
+
+#define IMGUI_SUGAR_SCOPED_GUARD(GUARD, ...) \
+    if (const ImGuiSugar::GUARD IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {__VA_ARGS__})
+
+#define IMGUI_SUGAR_PARENT_SCOPED_GUARD(GUARD, ...) \
+    const ImGuiSugar::GUARD IMGUI_SUGAR_CONCAT1(_ui_scope_, __LINE__) = {__VA_ARGS__}
+
+// Batched guards: __VA_ARGS__ is a list of braced ITEMs, GUARD is templated on its size
+
+#define IMGUI_SUGAR_SCOPED_BATCH(GUARD, ITEM, ...) \
+    if (const ImGuiSugar::GUARD<sizeof(ImGuiSugar::CountOf<ImGuiSugar::ITEM>({__VA_ARGS__}))> IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {{__VA_ARGS__}})
+
+#define IMGUI_SUGAR_PARENT_SCOPED_BATCH(GUARD, ITEM, ...) \
+    const ImGuiSugar::GUARD<sizeof(ImGuiSugar::CountOf<ImGuiSugar::ITEM>({__VA_ARGS__}))> IMGUI_SUGAR_CONCAT1(_ui_scope_, __LINE__) = {{__VA_ARGS__}}
 
 // ---------------------------------------------------------------------------
 // [SECTION] ImGui DSL
@@ -158,6 +3461,7 @@ namespace ImGuiSugar
 #define with_ItemWidth(...)          IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushItemWidth,          ImGui::PopItemWidth,          __VA_ARGS__)
 #define with_TextWrapPos(...)        IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushTextWrapPos,        ImGui::PopTextWrapPos,        __VA_ARGS__)
 #define with_ID(...)                 IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushID,                 ImGui::PopID,                 __VA_ARGS__)
+#define with_IDf(...)                IMGUI_SUGAR_SCOPED_VOID_N(ImGuiSugar::PushIDf,           ImGui::PopID,                 __VA_ARGS__)
 #define with_ClipRect(...)           IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushClipRect,           ImGui::PopClipRect,           __VA_ARGS__)
 #define with_TextureID(...)          IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushTextureID,          ImGui::PopTextureID,          __VA_ARGS__)
 
@@ -169,9 +3473,17 @@ namespace ImGuiSugar
 #define set_ItemWidth(...)           IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushItemWidth,          ImGui::PopItemWidth,          __VA_ARGS__)
 #define set_TextWrapPos(...)         IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushTextWrapPos,        ImGui::PopTextWrapPos,        __VA_ARGS__)
 #define set_ID(...)                  IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushID,                 ImGui::PopID,                 __VA_ARGS__)
+#define set_IDf(...)                 IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGuiSugar::PushIDf,           ImGui::PopID,                 __VA_ARGS__)
 #define set_ClipRect(...)            IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushClipRect,           ImGui::PopClipRect,           __VA_ARGS__)
 #define set_TextureID(...)           IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushTextureID,          ImGui::PopTextureID,          __VA_ARGS__)
 
+// IDs hashed at compile time (IMGUI_SUGAR_ENABLE_INTERNAL only, PushOverrideID is internal)
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+#define with_StaticID(LITERAL)       IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushOverrideID,                ImGui::PopID,                 IMGUI_SUGAR_STATIC_ID(LITERAL))
+#define set_StaticID(LITERAL)        IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushOverrideID,         ImGui::PopID,                 IMGUI_SUGAR_STATIC_ID(LITERAL))
+#endif
+
 // Special case (overloaded functions StyleColor, StyleVar and Indent)
 
 #define set_StyleColor(...)          IMGUI_SUGAR_PARENT_SCOPED_VOID_N(ImGui::PushStyleColor,  ImGuiSugar::PopStyleColor,           __VA_ARGS__)
@@ -182,9 +3494,219 @@ namespace ImGuiSugar
 #define with_StyleVar(...)           IMGUI_SUGAR_SCOPED_VOID_N(ImGui::PushStyleVar,           ImGuiSugar::PopStyleVar,             __VA_ARGS__)
 #define with_Indent(...)             IMGUI_SUGAR_SCOPED_VOID_N(ImGui::Indent,                 ImGuiSugar::Unindent,                __VA_ARGS__)
 
+// Batched style scopes: N pushes, one PopStyleColor(N)/PopStyleVar(N)
+// Usage: with_StyleColors({ImGuiCol_Text, color}, {ImGuiCol_WindowBg, color}) { ... }
+
+#define with_StyleColors(...)        IMGUI_SUGAR_SCOPED_BATCH(StyleColorsGuard,        StyleColor, __VA_ARGS__)
+#define with_StyleVars(...)          IMGUI_SUGAR_SCOPED_BATCH(StyleVarsGuard,          StyleVar,   __VA_ARGS__)
+#define set_StyleColors(...)         IMGUI_SUGAR_PARENT_SCOPED_BATCH(StyleColorsGuard, StyleColor, __VA_ARGS__)
+#define set_StyleVars(...)           IMGUI_SUGAR_PARENT_SCOPED_BATCH(StyleVarsGuard,   StyleVar,   __VA_ARGS__)
+
+// Whole style swap: one ImGuiStyle copy in, one copy out
+
+#define with_Style(...)              IMGUI_SUGAR_SCOPED_GUARD(StyleGuard,        __VA_ARGS__)
+#define set_Style(...)               IMGUI_SUGAR_PARENT_SCOPED_GUARD(StyleGuard, __VA_ARGS__)
+
+// Theme delta: only pushes the entries that differ, one pop per stack
+
+#define with_Theme(...)              IMGUI_SUGAR_SCOPED_GUARD(ThemeGuard,        __VA_ARGS__)
+#define set_Theme(...)               IMGUI_SUGAR_PARENT_SCOPED_GUARD(ThemeGuard, __VA_ARGS__)
+
+// Allocation regression gates (IMGUI_SUGAR_ALLOC_STATS only), ImGui::MemAlloc allocations only
+
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+#define with_AllocationLimit(...)    IMGUI_SUGAR_SCOPED_GUARD(AllocationLimitGuard,        __VA_ARGS__)
+#define set_AllocationLimit(...)     IMGUI_SUGAR_PARENT_SCOPED_GUARD(AllocationLimitGuard, __VA_ARGS__)
+#define with_NoAllocations           IMGUI_SUGAR_SCOPED_GUARD(AllocationLimitGuard,        0)
+#define set_NoAllocations            IMGUI_SUGAR_PARENT_SCOPED_GUARD(AllocationLimitGuard, 0)
+#endif
+
+// Virtualized lists: the loop body only runs for visible items (plus included ones)
+//   with_ListClipper(i, count) { ImGui::Text("Item %d", i); }
+//   with_ListClipper(i, count, offsets) { ... }  // Variable heights, see ImGuiSugar::ListClipper
+
+#define with_ListClipper(VAR, ...) for (const int VAR : ImGuiSugar::ListClipper(__VA_ARGS__))
+
+// Virtualized table rows (inside with_Table), each iteration already called TableNextRow
+//   with_TableRows(row, count) { ImGui::TableNextColumn(); ... }
+//   with_TableRows(row, count, frozenRows, rowHeight, rowFlags) { ... }  // See ImGuiSugar::TableClipper
+
+#define with_TableRows(VAR, ...)   for (const int VAR : ImGuiSugar::TableClipper(__VA_ARGS__))
+
+// Virtualized tree (ImGuiSugar::FlatTree kept across frames), the body runs for every visible node
+// (IMGUI_SUGAR_ENABLE_INTERNAL only)
+//   with_FlatTree(node, tree) { ImGui::SameLine(); ImGui::TextDisabled("%d", Size(node)); }
+
+#ifdef IMGUI_SUGAR_ENABLE_INTERNAL
+#define with_FlatTree(VAR, TREE)   for (const ImU64 VAR : ImGuiSugar::FlatTreeClipper(TREE))
+#endif
+
+// Draw list memoization: the body only runs when hash changes, otherwise its geometry is replayed
+//   with_CachedRegion("legend", hash) { ... }
+//   with_CachedRegion("legend", hash, true) { ... }  // Interactive: runs while hovered or an item is active
+
+#define with_CachedRegion(...)     IMGUI_SUGAR_SCOPED_GUARD(CachedRegionGuard, __VA_ARGS__)
+
+// Frame time budget and low priority children, skipped (replaying their last output) once it is spent
+//   with_Budget(4000) { ... with_LowPriority("plot") { ... } }
+
+#define with_Budget(...)           IMGUI_SUGAR_SCOPED_GUARD(BudgetGuard,      __VA_ARGS__)
+#define set_Budget(...)            IMGUI_SUGAR_PARENT_SCOPED_GUARD(BudgetGuard, __VA_ARGS__)
+#define with_LowPriority(...)      IMGUI_SUGAR_SCOPED_GUARD(LowPriorityGuard, __VA_ARGS__)
+
+// Tree node with asynchronously loaded children (IMGUI_SUGAR_ENABLE_ASYNC only), the body runs once per child
+//   with_AsyncTreeNode(child, cache, node, label) { ImGui::TextUnformatted(child.label.c_str()); }
+
+#ifdef IMGUI_SUGAR_ENABLE_ASYNC
+#define with_AsyncTreeNode(VAR, CACHE, ...) \
+    if (const ImGuiSugar::AsyncTreeNodeGuard IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ) = {CACHE, __VA_ARGS__}) \
+        for (const ImGuiSugar::AsyncChild& VAR : IMGUI_SUGAR_CONCAT1( _ui_scope_guard, __LINE__ ).Children())
+#endif
+
 // Non RAII 
 
 #define with_CollapsingHeader(...) if (ImGui::CollapsingHeader(__VA_ARGS__))
 #define with_MenuItem(...) if (ImGui::MenuItem(__VA_ARGS__))
 
+// ----------------------------------------------------------------------------
+// [SECTION] Scope instrumentation windows (IMGUI_SUGAR_*_STATS)
+// ----------------------------------------------------------------------------
+
+#ifdef IMGUI_SUGAR_STATS
+
+namespace ImGuiSugar
+{
+    // Per site p50/p95/p99/max of the time spent per frame, in microseconds
+    inline void ShowScopeStatsWindow(bool* p_open = nullptr)
+    {
+        with_Window("Scope statistics", p_open)
+        {
+            ScopeStatsContext& ctx = GetScopeStatsContext();
+            ImGui::Text("Sampling 1 of %d frames", ctx.sampleEvery);
+            ImGui::SameLine();
+            if (ImGui::Button("Reset")) { ResetScopeStats(); }
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+            with_Table("##scope_stats", 7, flags)
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Site", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Frames");
+                ImGui::TableSetupColumn("p50 (us)");
+                ImGui::TableSetupColumn("p95 (us)");
+                ImGui::TableSetupColumn("p99 (us)");
+                ImGui::TableSetupColumn("max (us)");
+                ImGui::TableHeadersRow();
+
+                for (const ScopeSite* site = GetFirstScopeSite(); site; site = site->next)
+                {
+                    const ScopeTimings t = GetScopeTimings(*site);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(site->name);
+                    ImGui::TableNextColumn(); ImGui::Text("%s:%d", site->file, site->line);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(t.samples));
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", t.p50 / 1000.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", t.p95 / 1000.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", t.p99 / 1000.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", t.max / 1000.0);
+                }
+            }
+        }
+    }
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_STATS
+
+#ifdef IMGUI_SUGAR_DRAW_STATS
+
+namespace ImGuiSugar
+{
+    // Per site vertices, indices and draw commands added in the last frame (and worst frame)
+    inline void ShowScopeDrawStatsWindow(bool* p_open = nullptr)
+    {
+        with_Window("Scope draw cost", p_open)
+        {
+            const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+            with_Table("##scope_draw_stats", 7, flags)
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Site", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Calls");
+                ImGui::TableSetupColumn("Vertices");
+                ImGui::TableSetupColumn("Indices");
+                ImGui::TableSetupColumn("Commands");
+                ImGui::TableSetupColumn("Worst vertices");
+                ImGui::TableHeadersRow();
+
+                for (const ScopeSite* site = GetFirstScopeSite(); site; site = site->next)
+                {
+                    ScopeDrawStats::Counts worst;
+                    const ScopeDrawStats::Counts last = GetScopeDrawCost(*site, &worst);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(site->name);
+                    ImGui::TableNextColumn(); ImGui::Text("%s:%d", site->file, site->line);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", last.calls);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", last.vtx);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", last.idx);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", last.cmd);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", worst.vtx);
+                }
+            }
+        }
+    }
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_DRAW_STATS
+
+#ifdef IMGUI_SUGAR_ALLOC_STATS
+
+namespace ImGuiSugar
+{
+    // Frame and per site ImGui allocations
+    inline void ShowScopeAllocStatsWindow(bool* p_open = nullptr)
+    {
+        with_Window("Scope allocations", p_open)
+        {
+            const AllocationTracker& tracker = GetAllocationTracker();
+            const ScopeAllocStats::Counts frame = GetFrameAllocations();
+            ImGui::Text("Last frame: %u allocations, %llu bytes", frame.allocs, static_cast<unsigned long long>(frame.bytes));
+            ImGui::Text("Live: %llu bytes, peak: %llu bytes",
+                        static_cast<unsigned long long>(tracker.liveBytes.load()), static_cast<unsigned long long>(tracker.peakBytes.load()));
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+            with_Table("##scope_alloc_stats", 6, flags)
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Site", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Allocs");
+                ImGui::TableSetupColumn("Bytes");
+                ImGui::TableSetupColumn("Total allocs");
+                ImGui::TableSetupColumn("Total bytes");
+                ImGui::TableHeadersRow();
+
+                for (const ScopeSite* site = GetFirstScopeSite(); site; site = site->next)
+                {
+                    ScopeAllocStats::Counts total;
+                    const ScopeAllocStats::Counts last = GetScopeAllocations(*site, &total);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(site->name);
+                    ImGui::TableNextColumn(); ImGui::Text("%s:%d", site->file, site->line);
+                    ImGui::TableNextColumn(); ImGui::Text("%u", last.allocs);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(last.bytes));
+                    ImGui::TableNextColumn(); ImGui::Text("%u", total.allocs);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(total.bytes));
+                }
+            }
+        }
+    }
+
+} // namespace ImGuiSugar
+
+#endif // IMGUI_SUGAR_ALLOC_STATS
+
 // clang-format on
@@ -0,0 +1,119 @@
+// Regression check of the frame string writer: ImGuiSugar::Fixed(value, decimals) must print
+// exactly what snprintf("%.*f", decimals, value) prints, at every magnitude, and so must the
+// TableNumericCells batches built with AppendNumericCell.
+
+#include <imgui.h>
+#include <imgui_sugar.hpp>
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+    int failures = 0;
+    int checked = 0;
+
+    void Check(const double value, const int decimals)
+    {
+        char expected[400];
+        snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+
+        char written[400];
+        char* out = written;
+        ImGuiSugar::WritePiece(out, ImGuiSugar::Fixed(value, decimals));
+        *out = 0;
+
+        ++checked;
+        if (strcmp(expected, written) != 0 && failures++ < 20)
+        {
+            printf("Fixed(%.17g, %d): \"%s\", printf: \"%s\"\n", value, decimals, written, expected);
+        }
+    }
+
+    // Cells appended back to back, as TableNumericCells does for a column
+    void CheckCells(const double* values, const int count, const int decimals)
+    {
+        ImVector<char> text;
+        ImVector<int> offsets;
+        for (int i = 0; i < count; ++i) { offsets.push_back(ImGuiSugar::AppendNumericCell(text, ImGuiSugar::Fixed(values[i], decimals))); }
+        offsets.push_back(text.Size);
+
+        for (int i = 0; i < count; ++i)
+        {
+            char expected[400];
+            snprintf(expected, sizeof(expected), "%.*f", decimals, values[i]);
+            const int length = offsets[i + 1] - offsets[i];
+
+            ++checked;
+            if ((length != static_cast<int>(strlen(expected)) || memcmp(expected, text.Data + offsets[i], static_cast<size_t>(length)) != 0) && failures++ < 20)
+            {
+                printf("Cell(%.17g, %d): \"%.*s\", printf: \"%s\"\n", values[i], decimals, length, text.Data + offsets[i], expected);
+            }
+        }
+    }
+
+    void CheckAllDecimals(const double value)
+    {
+        for (int decimals = 0; decimals <= 9; ++decimals)
+        {
+            Check(value, decimals);
+            Check(-value, decimals);
+        }
+    }
+
+    // Deterministic xorshift, for random bit patterns
+    ImU64 state = 0x9E3779B97F4A7C15ULL;
+    auto NextBits() -> ImU64
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+} // namespace
+
+int main()
+{
+    const double values[] = {
+        0.0, 0.5, 1.5, 2.5, 0.125, 0.375, 1.0 / 3.0, 2.0 / 3.0, 0.1, 0.05, 0.005, 0.0005, 1e-9, 5e-10, 4.9e-10,
+        1.005, 2.675, 123.456, 99.995, 999999.9995, 4294967295.5, 1e8, 999999999.5,
+        // Large magnitudes: the fraction still matters up to 2^53
+        1e9, 1e9 + 0.25, 1e9 + 0.5, 1.5e9 + 0.125, 1234567890.123, 9876543210.987654, 1.5e10, 12345678901.0625,
+        123456789012.345, 1e12 + 0.5, 4503599627370495.5, 9007199254740991.0, 9007199254740992.0,
+        // Integers up to and beyond ImU64
+        1e15 + 0.5, 1e16, 1e17, 1e18, 9.2233720368547758e18, 1.8446744073709550e19, 1.8446744073709552e19, 1e19, 1e20,
+        1.2345678901234567e25, 1e100, 1e300, DBL_MAX,
+        // Tiny values, subnormals
+        DBL_MIN, 4.9406564584124654e-324, 1e-300, 2.5e-10, 1e-20};
+    for (const double value : values) { CheckAllDecimals(value); }
+
+    // Random doubles over all exponents, and over the usual UI range
+    for (int i = 0; i < 200000; ++i)
+    {
+        ImU64 bits = NextBits() & ~(0x7FFULL << 52);
+        bits |= (NextBits() % 2047) << 52; // Any finite exponent
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        Check(value, static_cast<int>(NextBits() % 10));
+
+        const double scaled = static_cast<double>(NextBits() >> 11) / static_cast<double>(1ULL << (NextBits() % 53));
+        Check(scaled, static_cast<int>(NextBits() % 10));
+    }
+
+    // Ties: k / 2^n with few bits are exact in binary
+    for (int k = 0; k < 4096; ++k)
+    {
+        for (int n = 1; n <= 12; ++n) { CheckAllDecimals(static_cast<double>(k) / static_cast<double>(1 << n) + 1e9 * (k % 3)); }
+    }
+
+    // Numeric table columns with large magnitudes (totals, byte counts, timestamps in ns)
+    const double column[] = {
+        0.0, -1.5, 999999999.995, 1e9, 1e9 + 0.5, -1234567890.125, 98765432109.875, 1.5e12 + 0.25, 4503599627370495.5,
+        9.2233720368547758e18, 1.8446744073709552e19, 1e19, -1e21, 1.2345678901234567e25, 1e100, -1e300, DBL_MAX};
+    const int columnSize = static_cast<int>(sizeof(column) / sizeof(column[0]));
+    for (int decimals = 0; decimals <= 9; ++decimals) { CheckCells(column, columnSize, decimals); }
+
+    printf("fixed format: %d values checked, %d mismatch(es)\n", checked, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Headless check of IdleFramePolicy: an event loop driven by GetWaitTimeout() must stop
+// producing frames (wait without timeout, no CPU) once a static UI has settled, and keep
+// producing them at io.KeyRepeatRate while a mouse button or a key is held.
+
+#include <imgui.h>
+#include <imgui_sugar.hpp>
+#include <stdio.h>
+
+namespace
+{
+    int failures = 0;
+
+#define CHECK(EXPR) do { if (!(EXPR)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #EXPR); ++failures; } } while (false)
+
+    void Frame(ImGuiSugar::IdleFramePolicy& idle, const double deltaTime)
+    {
+        ImGui::GetIO().DeltaTime = static_cast<float>(deltaTime);
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(10, 10));
+        with_Window("Static") { ImGui::TextUnformatted("Nothing changes"); }
+        ImGui::Render();
+        idle.EndFrame();
+    }
+
+    // Frames run in `seconds` of simulated time by a loop that gets no input event
+    auto FramesWithoutEvents(ImGuiSugar::IdleFramePolicy& idle, const double seconds) -> int
+    {
+        int frames = 0;
+        for (double time = 0.0; time < seconds; ++frames)
+        {
+            const double timeout = idle.GetWaitTimeout();
+            if (timeout < 0.0) { break; } // Blocks until an event arrives
+            const double step = timeout > 0.0 ? timeout : 1.0 / 60.0; // Vsync paced frame
+            time += step;
+            Frame(idle, step);
+        }
+        return frames;
+    }
+
+    void SetMouseDown(const bool down)
+    {
+#if IMGUI_VERSION_NUM >= 18700
+        ImGui::GetIO().AddMouseButtonEvent(0, down);
+#else
+        ImGui::GetIO().MouseDown[0] = down;
+#endif
+    }
+
+    void SetKeyDown(const bool down)
+    {
+#if IMGUI_VERSION_NUM >= 18700
+        ImGui::GetIO().AddKeyEvent(ImGuiKey_A, down);
+#else
+        ImGui::GetIO().KeysDown['A'] = down;
+#endif
+    }
+
+} // namespace
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    ImGuiSugar::IdleFramePolicy idle;
+    const int settle = idle.settleFrames + 2;
+
+    // Static UI: a few frames to settle, then no frame at all for 10 seconds
+    CHECK(FramesWithoutEvents(idle, 10.0) <= settle);
+    CHECK(idle.IsIdle());
+    CHECK(idle.GetWaitTimeout() < 0.0);
+
+    // Mouse button held over nothing: the frame does not change but must keep running
+    SetMouseDown(true);
+    Frame(idle, 1.0 / 60.0);
+    const double repeatRate = static_cast<double>(io.KeyRepeatRate);
+    CHECK(idle.GetWaitTimeout() >= 0.0 && idle.GetWaitTimeout() <= repeatRate);
+    const int mouseFrames = FramesWithoutEvents(idle, 1.0);
+    CHECK(mouseFrames >= static_cast<int>(0.9 / repeatRate));
+    SetMouseDown(false);
+    CHECK(FramesWithoutEvents(idle, 10.0) <= settle);
+
+    // Key held: same
+    SetKeyDown(true);
+    Frame(idle, 1.0 / 60.0);
+    const int keyFrames = FramesWithoutEvents(idle, 1.0);
+    CHECK(keyFrames >= static_cast<int>(0.9 / repeatRate));
+    SetKeyDown(false);
+    CHECK(FramesWithoutEvents(idle, 10.0) <= settle);
+
+    printf("idle frames: mouse held %d frames/s, key held %d frames/s, %d failure(s)\n", mouseFrames, keyFrames, failures);
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+// Check of the compile time IDs: IMGUI_SUGAR_STATIC_ID(literal) and with_StaticID(literal)
+// must give the IDs of ImGui::GetID(literal) and ImGui::PushID(literal) under any seed,
+// for empty, long, "#"/"##"/"###" and non ASCII literals. The CRC folding itself is also
+// checked against ImHashStr on random strings and seeds.
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_sugar.hpp>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+    int failures = 0;
+    int checked = 0;
+
+#define CHECK(EXPR) do { ++checked; if (!(EXPR) && failures++ < 20) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #EXPR); } } while (false)
+
+    ImU32 state = 0x9E3779B9u;
+
+    auto Random() -> ImU32
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // CombineStaticID with the constant and length given at runtime, for random strings
+    const int MaxLength = 48;
+
+    using Combiner = ImGuiID (*)(ImU32 constant, ImGuiID seed);
+
+    template<int Length>
+    auto CombineAt(const ImU32 constant, const ImGuiID seed) -> ImGuiID
+    {
+        return ~(ImGuiSugar::ZeroBytes<Length>(~seed) ^ constant);
+    }
+
+    template<int Length>
+    struct FillCombiners
+    {
+        static void Fill(Combiner* table)
+        {
+            table[Length] = &CombineAt<Length>;
+            FillCombiners<Length - 1>::Fill(table);
+        }
+    };
+
+    template<>
+    struct FillCombiners<-1>
+    {
+        static void Fill(Combiner*) {}
+    };
+
+    void CheckRandomStrings()
+    {
+        Combiner combiners[MaxLength + 1];
+        FillCombiners<MaxLength>::Fill(combiners);
+
+        // Few distinct characters, so "#" runs of every length show up
+        const char alphabet[] = "###ab\x7f\x80\xff";
+        char str[MaxLength + 1];
+        for (int i = 0; i < 100000; ++i)
+        {
+            const int length = static_cast<int>(Random() % (MaxLength + 1));
+            for (int c = 0; c < length; ++c)
+            {
+                str[c] = (Random() & 1) ? alphabet[Random() % (sizeof(alphabet) - 1)] : static_cast<char>(1 + Random() % 255);
+            }
+            str[length] = 0;
+
+            const ImGuiID seed = (i % 16 == 0) ? 0u : ((i % 16 == 1) ? 0xFFFFFFFFu : Random());
+            const ImGuiID folded = combiners[ImGuiSugar::StaticIDLength(str)](ImGuiSugar::StaticIDConstant(str), seed);
+            CHECK(folded == ImHashStr(str, 0, seed));
+        }
+    }
+
+    // Literals given to the macros, with and without "###" restarts
+#define STATIC_ID_LITERALS(X) \
+    X("") \
+    X("a") \
+    X("OK") \
+    X("Button") \
+    X("#") \
+    X("##") \
+    X("###") \
+    X("####") \
+    X("#####") \
+    X("##hidden") \
+    X("label###id") \
+    X("label##suffix") \
+    X("a###b###c") \
+    X("a#b##c###d") \
+    X("trailing###") \
+    X("\xc3\xa9t\xc3\xa9") \
+    X("\x7f\x80\xfe\xff") \
+    X("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. " \
+      "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. " \
+      "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.")
+
+#define CHECK_LITERAL(LITERAL) \
+    CHECK(IMGUI_SUGAR_STATIC_ID(LITERAL) == ImGui::GetID(LITERAL)); \
+    { \
+        ImGuiID inside = 0; \
+        with_StaticID(LITERAL) { inside = ImGui::GetID("child"); } \
+        ImGui::PushID(LITERAL); \
+        CHECK(inside == ImGui::GetID("child")); \
+        ImGui::PopID(); \
+    }
+
+    void CheckLiterals()
+    {
+        STATIC_ID_LITERALS(CHECK_LITERAL)
+    }
+
+} // namespace
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    ImGui::NewFrame();
+    with_Window("Static IDs")
+    {
+        // Window seed, nested ID scopes and explicit seeds
+        CheckLiterals();
+        with_ID("parent") { with_ID(42) { CheckLiterals(); } }
+        const ImGuiID seeds[] = {0u, 1u, 0x80000000u, 0xFFFFFFFFu, Random(), Random(), Random(), Random()};
+        for (const ImGuiID seed : seeds)
+        {
+            ImGui::PushOverrideID(seed);
+            CheckLiterals();
+            ImGui::PopID();
+        }
+        ImGuiID inside = 0;
+        {
+            set_StaticID("set###scope");
+            inside = ImGui::GetID("child");
+        }
+        with_ID("set###scope") { CHECK(inside == ImGui::GetID("child")); }
+    }
+    ImGui::Render();
+
+    CheckRandomStrings();
+
+    printf("static ids: %d checks, %d failure(s)\n", checked, failures);
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
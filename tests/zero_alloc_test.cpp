@@ -0,0 +1,213 @@
+// Zero allocation gate: a reference UI going through every with_*/set_* scope (plus the
+// virtualized, cached and text helpers) must not allocate once warm. Both the global
+// operator new/delete and the ImGui allocator are counted, frames 100 to 1100 must make
+// no allocation at all.
+//
+// with_AsyncTreeNode (allocates by design) and with_AllocationLimit/with_NoAllocations
+// (they install their own allocator) are not covered.
+
+#include <imgui.h>
+#include <imgui_sugar.hpp>
+#include <new>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace
+{
+    bool counting = false;
+    int allocations = 0;
+
+    auto CountingAlloc(const size_t size, void*) -> void*
+    {
+        if (counting) { ++allocations; }
+        return malloc(size);
+    }
+
+    void CountingFree(void* ptr, void*) { free(ptr); }
+
+    auto CountedNew(const size_t size) -> void*
+    {
+        if (counting) { ++allocations; }
+        void* ptr = malloc(size > 0 ? size : 1);
+        if (ptr == nullptr) { throw std::bad_alloc(); }
+        return ptr;
+    }
+
+} // namespace
+
+void* operator new(size_t size) { return CountedNew(size); }
+void* operator new[](size_t size) { return CountedNew(size); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+
+namespace
+{
+    const int WarmUpFrames = 100;
+    const int CheckedFrames = 1000;
+
+    ImGuiStyle lightStyle;
+    ImGuiSugar::ThemeDelta* theme = nullptr;
+    ImGuiSugar::FlatTree* flatTree = nullptr;
+    char wrappedText[100 * 1024];
+
+    // 3 levels of 4 children, all open
+    struct ReferenceTree : ImGuiSugar::TreeSource
+    {
+        auto GetChildCount(const ImU64 node) -> int override { return node < 5 ? 4 : 0; }
+        auto GetChild(const ImU64 node, const int index) -> ImU64 override { return node * 4 + 1 + static_cast<ImU64>(index); }
+        auto GetLabel(const ImU64 node) -> const char* override { return node % 2 == 0 ? "even" : "odd"; }
+        auto GetFlags(ImU64) -> ImGuiTreeNodeFlags override { return ImGuiTreeNodeFlags_DefaultOpen; }
+    };
+
+    void TreeNodeV(const char* fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        ImGui::SetNextItemOpen(true);
+        with_TreeNodeV("v", fmt, args) { ImGui::TextUnformatted("x"); }
+        with_TreeNodeExV("ex v", ImGuiTreeNodeFlags_DefaultOpen, fmt, args) { ImGui::TextUnformatted("x"); }
+        va_end(args);
+    }
+
+    void ParentScopes(const int frame)
+    {
+        set_Font(ImGui::GetFont());
+        set_AllowKeyboardFocus(false);
+        set_ButtonRepeat(true);
+        set_ItemWidth(100.0f);
+        set_TextWrapPos(400.0f);
+        set_ID(frame % 8);
+        set_IDf("row", frame % 8);
+        set_StaticID("static");
+        set_ClipRect(ImVec2(0, 0), ImVec2(800, 600), true);
+        set_TextureID(ImGui::GetIO().Fonts->TexID);
+        set_StyleColor(ImGuiCol_Text, 0xff00ff00);
+        set_StyleVar(ImGuiStyleVar_Alpha, 0.9f);
+        set_Indent(4.0f);
+        set_StyleColors({ImGuiCol_Button, 0xff0000ff}, {ImGuiCol_Border, 0xffff0000});
+        set_StyleVars({ImGuiStyleVar_FrameRounding, 2.0f}, {ImGuiStyleVar_ItemSpacing, ImVec2(2, 2)});
+        set_Style(lightStyle);
+        set_Theme(*theme);
+        set_Budget(1000000);
+        ImGui::TextUnformatted("parent scoped");
+    }
+
+    void ReferenceUi(const int frame)
+    {
+        with_MainMenuBar { with_Menu("File") { ImGui::TextUnformatted("x"); } }
+
+        ImGui::SetNextWindowPos(ImVec2(0, 20));
+        ImGui::SetNextWindowSize(ImVec2(800, 580));
+        with_Window("Reference", nullptr, ImGuiWindowFlags_MenuBar | ImGuiWindowFlags_NoSavedSettings)
+        {
+            with_MenuBar { with_Menu("Edit") { ImGui::TextUnformatted("x"); } with_MenuItem("Undo") {} }
+
+            if (frame == 0) { ImGui::OpenPopup("popup"); }
+            with_Popup("popup") { ImGui::TextUnformatted("in popup"); }
+            with_PopupModal("modal") { ImGui::TextUnformatted("x"); }
+            ImGui::Button("item");
+            with_PopupContextItem("item context") { ImGui::TextUnformatted("x"); }
+            with_PopupContextWindow("window context") { ImGui::TextUnformatted("x"); }
+            with_PopupContextVoid("void context") { ImGui::TextUnformatted("x"); }
+            with_TooltipOnHover { ImGui::TextUnformatted("x"); }
+            with_Tooltip { ImGui::TextUnformatted("tooltip"); }
+            with_DragDropSource() { ImGui::TextUnformatted("x"); }
+            with_DragDropTarget { ImGui::TextUnformatted("x"); }
+
+            with_Child("child", ImVec2(200, 60), true) { ImGui::TextUnformatted("in child"); }
+            with_ChildFrame(ImGui::GetID("frame"), ImVec2(200, 40)) { ImGui::TextUnformatted("in frame"); }
+            with_Combo("combo", "preview") { ImGui::TextUnformatted("x"); }
+            with_ListBox("list", ImVec2(200, 40)) { ImGui::Selectable("a"); ImGui::Selectable("b"); }
+            with_Group { ImGui::TextUnformatted("grouped"); }
+
+            with_TabBar("tabs") { with_TabItem("A") { ImGui::TextUnformatted("a"); } with_TabItem("B") { ImGui::TextUnformatted("b"); } }
+
+            ImGui::SetNextItemOpen(true);
+            with_TreeNode("tree") { ImGui::TextUnformatted("x"); }
+            with_TreeNodeEx("tree ex", ImGuiTreeNodeFlags_DefaultOpen) { ImGui::TextUnformatted("x"); }
+            TreeNodeV("node %d", frame % 8);
+            ImGui::SetNextItemOpen(true);
+            with_CollapsingHeader("header") { ImGui::TextUnformatted("x"); }
+
+            with_Font(ImGui::GetFont()) { ImGui::TextUnformatted("x"); }
+            with_AllowKeyboardFocus(false) { ImGui::TextUnformatted("x"); }
+            with_ButtonRepeat(true) { ImGui::TextUnformatted("x"); }
+            with_ItemWidth(100.0f) { ImGui::TextUnformatted("x"); }
+            with_TextWrapPos(300.0f) { ImGui::TextUnformatted("x"); }
+            with_ID(frame % 8) { ImGui::TextUnformatted("x"); }
+            with_IDf("label##", frame % 8) { ImGui::TextUnformatted("x"); }
+            with_StaticID("static") { ImGui::TextUnformatted("x"); }
+            with_ClipRect(ImVec2(0, 0), ImVec2(400, 400), true) { ImGui::TextUnformatted("x"); }
+            with_TextureID(ImGui::GetIO().Fonts->TexID) { ImGui::TextUnformatted("x"); }
+            with_StyleColor(ImGuiCol_Text, 0xff00ff00) { ImGui::TextUnformatted("x"); }
+            with_StyleVar(ImGuiStyleVar_Alpha, 0.5f) { ImGui::TextUnformatted("x"); }
+            with_Indent(10.0f) { ImGui::TextUnformatted("x"); }
+            with_StyleColors({ImGuiCol_Text, 0xff00ff00}, {ImGuiCol_Button, 0xff0000ff}) { ImGui::TextUnformatted("x"); }
+            with_StyleVars({ImGuiStyleVar_Alpha, 0.5f}, {ImGuiStyleVar_ItemSpacing, ImVec2(2, 2)}) { ImGui::TextUnformatted("x"); }
+            with_Style(lightStyle) { ImGui::TextUnformatted("x"); }
+            with_Theme(*theme) { ImGui::TextUnformatted("x"); }
+            ParentScopes(frame);
+
+            ImGui::Button(ImGuiSugar::Label("Delete##", frame % 8));
+            ImGuiSugar::TextFast("frame ", frame % 50, " ", ImGuiSugar::Fixed((frame % 50) * 0.25, 2)); // Every length is seen while warming up
+            ImGuiSugar::TextCached("OK");
+            with_Child("wrapped", ImVec2(400, 80)) { ImGuiSugar::TextWrappedCached("wrapped", wrappedText); }
+
+            with_Child("list clipper", ImVec2(200, 80)) { with_ListClipper(i, 100000) { ImGui::Text("%d", i); } }
+            with_Table("rows", 2, ImGuiTableFlags_ScrollY, ImVec2(300, 80))
+            {
+                with_TableRows(row, 100000) { ImGui::TableNextColumn(); ImGui::Text("%d", row); ImGui::TableNextColumn(); ImGui::TextUnformatted("x"); }
+            }
+            with_Table("numbers", 8, ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY, ImVec2(300, 80))
+            {
+                ImGuiSugar::TableNumericCells(10000, 3, [](const int row, const int column) { return row * 0.5 + column; });
+            }
+            with_Child("flat tree", ImVec2(200, 80)) { with_FlatTree(node, *flatTree) { (void)node; } }
+
+            with_CachedRegion("cached", 1) { ImGui::TextUnformatted("cached"); }
+            with_Budget(1000000) { with_LowPriority("low priority") { ImGui::TextUnformatted("low priority"); } }
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    ImGui::SetAllocatorFunctions(&CountingAlloc, &CountingFree, nullptr);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    ImGui::StyleColorsLight(&lightStyle);
+    ImGuiSugar::ThemeDelta lightTheme(ImGui::GetStyle(), lightStyle);
+    theme = &lightTheme;
+    ReferenceTree source;
+    ImGuiSugar::FlatTree tree(source, 0);
+    flatTree = &tree;
+    for (size_t i = 0; i + 1 < sizeof(wrappedText); ++i) { wrappedText[i] = i % 7 == 6 ? ' ' : static_cast<char>('a' + i % 26); }
+
+    int failures = 0;
+    for (int frame = 0; frame < WarmUpFrames + CheckedFrames; ++frame)
+    {
+        counting = frame >= WarmUpFrames;
+        allocations = 0;
+        ImGui::NewFrame();
+        ReferenceUi(frame);
+        ImGui::Render();
+        counting = false;
+        if (allocations > 0 && failures++ < 10) { printf("frame %d: %d allocation(s)\n", frame, allocations); }
+    }
+
+    printf("zero allocations: %d frame(s) allocated after warm-up\n", failures);
+    ImGuiSugar::ClearTextLayouts();
+    ImGuiSugar::ClearGlyphRuns();
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}